@@ -35,12 +35,111 @@ SOFTWARE.
 #include <vector>
 #include <tuple>
 #include <map>
+#include <deque>
 #include <algorithm>
 #include <stdexcept>
 #include <limits>
+#include <cstring>
+#include <cstdint>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <ostream>
+#include <memory>
+#include <new>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <type_traits>
+#include <functional>
+#include <mutex>
+#include <utility>
 
 #if __cplusplus > 201402L || _MSVC_LANG > 201402L
+#define ARGPARSE_HAS_CXX17
+#endif
+
+// compile time schema needs class types as template parameters
+#if (__cplusplus > 201703L || _MSVC_LANG > 201703L) && defined(__cpp_nontype_template_args)
+#if __cpp_nontype_template_args >= 201911L
+#define ARGPARSE_HAS_CXX20
+#endif
+#endif
+
+#if (__cplusplus > 201703L || _MSVC_LANG > 201703L) && defined(__has_include)
+#if __has_include(<span>)
+#define ARGPARSE_HAS_SPAN
+#endif
+#endif
+
+#ifdef ARGPARSE_HAS_CXX17
 #include <any>
+#include <charconv>
+#include <string_view>
+#endif
+
+#ifdef ARGPARSE_HAS_SPAN
+#include <span>
+#endif
+
+// define ARGPARSE_USE_PMR to keep parse results in std::pmr containers
+// and to pass your own std::pmr::memory_resource to ParseArgs
+#ifdef ARGPARSE_USE_PMR
+#ifndef ARGPARSE_HAS_CXX17
+#error "ARGPARSE_USE_PMR requires c++17"
+#endif
+#include <memory_resource>
+#endif
+
+// define ARGPARSE_ENABLE_STATS to collect timings and counters of every parse, see ParseStats.
+// Define ARGPARSE_STATS_IMPLEMENTATION in one translation unit too, to count allocations
+// by replacement of global operator new
+#ifdef ARGPARSE_ENABLE_STATS
+#include <chrono>
+#include <cstdlib>
+#define ARGPARSE_STATS(statement) statement
+#else
+#define ARGPARSE_STATS(statement)
+#endif
+
+// response files (@file arguments) and config files are read into memory.
+// Define ARGPARSE_USE_MMAP to map them instead, it pulls platform headers
+// (windows.h or POSIX mman, fcntl and unistd) into every includer.
+#ifdef ARGPARSE_USE_MMAP
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#define ARGPARSE_UNDEF_WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#define ARGPARSE_UNDEF_NOMINMAX
+#endif
+#include <windows.h>
+#ifdef ARGPARSE_UNDEF_WIN32_LEAN_AND_MEAN
+#undef WIN32_LEAN_AND_MEAN
+#undef ARGPARSE_UNDEF_WIN32_LEAN_AND_MEAN
+#endif
+#ifdef ARGPARSE_UNDEF_NOMINMAX
+#undef NOMINMAX
+#undef ARGPARSE_UNDEF_NOMINMAX
+#endif
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#else
+#include <fstream>
+#endif
+
+// environment is walked through environ, which POSIX requires program to declare itself
+#if defined(__APPLE__)
+#include <crt_externs.h>
+#elif !defined(_WIN32)
+extern char** environ;
 #endif
 
 /// @brief namespace of argument parser constants and Classes
@@ -48,1288 +147,5033 @@ SOFTWARE.
 /// By default is namespace name is "argparse"
 namespace ARGPARSE_NAMESPACE_NAME
 {
-    /// @brief anonymous namespace for internal usage
-    namespace 
-    {
-        const size_t kSizeTypeEnd = static_cast<size_t>(-1);
-        const size_t kHelpWidth = 80;
-        const size_t kHelpNameWidthPercent = 30;
-
-        bool isNumber(const std::string& inStr)
-        {
-            const bool hasNegSign = inStr.at(0) == '-';
-            size_t dotPos = 0, expPos = 0;
-            size_t startPos = static_cast<size_t>(hasNegSign);
-            for (size_t curPos = startPos; curPos < inStr.size(); ++curPos)
-            {
-                const char curChar = inStr.at(curPos);
-                if (curChar >= '0' && curChar <= '9')
-                {
-                    continue;
-                }
-                else if (curChar == '.'
-                    && !dotPos && curPos != startPos && curPos != inStr.size() - 1)
-                {
-                    dotPos = curPos;
-                }
-                else if ((curChar == 'e' || curChar == 'E')
-                    && !expPos && curPos != startPos && curPos != inStr.size() - 1)
-                {
-                    expPos = curPos;
-                    if (!dotPos)
-                    {
-                        return false;
-                    }
-                }
-                else
-                {
-                    return false;
-                }
-            }
-            return true;
-        }
-
-        size_t getStringStreamLength(std::stringstream& showDesc)
-        {
-            showDesc.seekp(0, std::ios::end);
-            return showDesc.tellp();
-        }
-    }
-
-
-    /// @brief Supported types for argument
-    /// If needed type is not in this list, then just use e_String
-    enum class ArgTypeCast : int
+#ifdef ARGPARSE_HAS_CXX17
+    /// @brief Non owning view of input token
+    using StringView = std::string_view;
+#else
+    /// @brief Non owning view of input token. Minimal replacement of std::string_view
+    /// for c++11 and c++14. Starting from c++17 it is alias to std::string_view.
+    class StringView
     {
-        e_String,
-        e_int,
-        e_longlong,
-        e_double,
-        e_bool
-    };
-
-    /// @brief constant to indicate arguments with various
-    /// count from 0 to infinite
-    const int kAnyArgCount = -1;
-    /// @brief constant to indicate arguments with various
-    /// count from 1 to infinite
-    const int kFromOneToInfinteArgCount = -2;
+    public:
+        StringView() noexcept
+            : m_data("")
+            , m_size(0)
+        {}
 
+        StringView(const char* str)
+            : m_data(str)
+            , m_size(std::strlen(str))
+        {}
 
-    class ArgumentParser;
-    class ArgumentsObject;
+        StringView(const char* str, size_t size) noexcept
+            : m_data(str)
+            , m_size(size)
+        {}
 
-    /// @brief This class represents argument configuration
-    /// which should be passed to ArgumentParser objects instance
-    class Argument
-    {
-        /// @brief Default constructor. Private!
-        /// @param positionalName represents name for positional argument.
-        /// @param shortName represents short name for named argument which should be passed with one prefix.
-        /// @param longName represents long name for named argument which should be passed with double prefix.
-        /// @param argsCount integer number. You can use "kAnyArgCount", "kFromOneToInfinteArgCount" for non strict count or any int constant.
-        /// @param argType type of argument. Defined via enum. Supported types are: int, long long, double and bool and string for all other cases.
-        /// @param required Is argument required. Will fail parsing, if required argument are not present.
-        /// @param help Your own custom help string start.
-        Argument(const std::string& positionalName = "",
-            const std::string& shortName = "",
-            const std::string& longName = "",
-            const int argsCount = 1,
-            ArgTypeCast argType = ArgTypeCast::e_String,
-            const bool required = true,
-            const std::string& help = "")
-            : m_required(required)
-            , m_nargs(argsCount)
-            , m_type(argType)
-            , m_positionalName(positionalName)
-            , m_shortName(shortName)
-            , m_longName(longName)
-            , m_help(help)
+        StringView(const std::string& str) noexcept
+            : m_data(str.data())
+            , m_size(str.size())
         {}
-    public:
 
-        /// @brief Default constructor positional arguments. You can use class Setters or pass your own values to public members directly.
-        /// @param shortName represents short name for named argument which should be passed with one prefix.
-        /// @param longName represents long name for named argument which should be passed with double prefix.
-        /// @param argsCount integer number. You can use "kAnyArgCount", "kFromOneToInfinteArgCount" for non strict count or any int constant.
-        /// @param argType type of argument. Defined via enum. Supported types are: int, long long, double and bool and string for all other cases.
-        /// @param required Is argument required. Will fail parsing, if required argument are not present.
-        /// @param help Your own custom help string start.
-        static Argument CreateNamedArgument(const std::string& shortName = "",
-            const std::string& longName = "",
-            const int argsCount = 1,
-            ArgTypeCast argType = ArgTypeCast::e_String,
-            const bool required = true,
-            const std::string& help = "")
+        const char* data() const noexcept
         {
-            return Argument("", shortName, longName, argsCount, argType, required, help);
+            return m_data;
         }
 
-        /// @brief Default function for named arguments. You can use class Setters or pass your own values to public members directly.
-        /// @param positionalName represents name for positional argument.
-        /// @param argsCount integer number. You can use "kAnyArgCount", "kFromOneToInfinteArgCount" for non strict count or any int constant.
-        /// @param argType type of argument. Defined via enum. Supported types are: int, long long, double and bool and string for all other cases.
-        /// @param required Is argument required. Will fail parsing, if required argument are not present.
-        /// @param help Your own custom help string start.
-        static Argument CreatePositionalArgument(const std::string& positionalName = "",
-            const int argsCount = 1,
-            ArgTypeCast argType = ArgTypeCast::e_String,
-            const bool required = true,
-            const std::string& help = "")
+        size_t size() const noexcept
         {
-            return Argument(positionalName, "", "", argsCount, argType, required, help);
+            return m_size;
         }
 
-        /// @brief required flag argument
-        /// If required argument is not set in command line
-        /// then parsing will fail.
-        /// All Arguments are required by default
-        bool m_required = true;
-
-        /// @brief Setter function to flag,
-        /// @param required - bool value to indicate is argument required or not
-        /// @return reference to current argument
-        Argument& SetRequired(bool required)
+        bool empty() const noexcept
         {
-            m_required = required;
-            return *this;
+            return m_size == 0;
         }
 
-        /// @brief variable that indicates count of argument in input
-        /// use "kAnyArgCount" or "kFromOneToInfinteArgCount" constants
-        /// for arguments with variable count. Any other arguments count
-        /// will be passed as strict arguments count.
-        /// 0 is for flags (arguments that doesn't carry any data)
-        /// set to 1 by default.
-        int m_nargs = 1;
-
-        /// @brief setter function for m_nargs with desired amount
-        /// @param amount int value that indicates  amount of argument.
-        /// Could be "kAnyArgCount" or "kFromOneToInfinteArgCount", 0 or any other positive integer.
-        /// @return reference to current argument
-        Argument& SetNumberOfArguments(int amount)
+        char operator[](size_t pos) const noexcept
         {
-            m_nargs = amount;
-            return *this;
+            return m_data[pos];
         }
 
-        /// @brief Handy setter for argument count with self declared name
-        /// @return reference to current argument
-        Argument& SetAnyNumberOfArgumentsButAtleastOne()
+        explicit operator std::string() const
         {
-            m_nargs = kFromOneToInfinteArgCount;
-            return *this;
+            return std::string(m_data, m_size);
         }
 
-        /// @brief Handy setter for argument count with self declared name
-        /// @return reference to current argument
-        Argument& SetAnyNumberOfArguments()
+        friend bool operator==(StringView lhs, StringView rhs) noexcept
         {
-            m_nargs = kAnyArgCount;
-            return *this;
+            return lhs.m_size == rhs.m_size && std::memcmp(lhs.m_data, rhs.m_data, lhs.m_size) == 0;
         }
 
-        /// @brief Handy setter for argument which is actually a flag (e.g. has no any parameters)
-        /// @return reference to current argument
-        Argument& SetArgumentIsFlag()
+        friend bool operator!=(StringView lhs, StringView rhs) noexcept
         {
-            m_nargs = 0;
-            return *this;
+            return !(lhs == rhs);
         }
 
-        /// @brief Variable that hold type of argument.
-        /// string by default
-        ArgTypeCast m_type = ArgTypeCast::e_String;
+        friend bool operator<(StringView lhs, StringView rhs) noexcept
+        {
+            const int compared = std::memcmp(lhs.m_data, rhs.m_data, lhs.m_size < rhs.m_size ? lhs.m_size : rhs.m_size);
+            return compared < 0 || (compared == 0 && lhs.m_size < rhs.m_size);
+        }
 
-        /// @brief Setter function for type of current argument
-        /// @param argType setter for type of current argument data.
-        /// Any non string types will be casted while parsing.
-        /// @return reference to current argument
-        Argument& SetType(ArgTypeCast argType)
+        friend std::ostream& operator<<(std::ostream& out, StringView view)
         {
-            m_type = argType;
-            return *this;
+            return out.write(view.m_data, static_cast<std::streamsize>(view.m_size));
         }
 
-        /// @brief name of positional argument
-        /// positional arguments name used only to access desired argument from code
-        std::string m_positionalName = "";
+    private:
+        const char* m_data;
+        size_t      m_size;
+    };
+#endif
 
-        /// @brief Handy setter for positional argument
-        /// @param name name for positional argument. Empty by default
-        /// @return reference to current argument
-        Argument& SetPositionalName(const std::string& name)
+    /// @brief namespace for internal classes, which can't be placed to anonymous namespace
+    namespace detail
+    {
+        /// @brief Token source over any range of string-like values
+        /// (char*, const char*, std::string, StringView).
+        /// Hands out views, so nothing is copied while walking input.
+        template<typename Iterator>
+        class RangeTokens
         {
-            m_positionalName = name;
-            return *this;
-        }
+        public:
+            RangeTokens(Iterator first, Iterator last)
+                : m_current(first)
+                , m_last(last)
+            {}
 
-        /// @brief arguments short name
-        /// for non positional argument only
-        /// shot name used in input with 1 prefix
-        std::string m_shortName = "";
+            /// @brief Function to take next token
+            /// @param token out parameter, view of next token
+            /// @return false if input is over
+            bool Next(StringView& token)
+            {
+                if (m_current == m_last)
+                {
+                    return false;
+                }
+                token = StringView(*m_current);
+                ++m_current;
+                return true;
+            }
 
-        /// @brief Handy setter for short named argument. 
-        /// Should been used with ordinary prefix in command line.
-        /// Can be auto-generated if possible when m_allowAbbrev in ArgymentParsed set to true.
-        /// @param name name for positional argument. Empty by default
-        /// @return reference to current argument
-        Argument& SetShortName(const std::string& name)
+            /// @brief Range of tokens never fails
+            bool HasError() const noexcept
+            {
+                return false;
+            }
+
+            const std::string& GetError() const
+            {
+                static const std::string empty;
+                return empty;
+            }
+
+        private:
+            Iterator m_current;
+            Iterator m_last;
+        };
+
+        /// @brief Whitespace which separates tokens in files and command line strings
+        inline bool isSpace(char sym) noexcept
         {
-            m_shortName = name;
-            return *this;
+            return sym == ' ' || sym == '\n' || sym == '\r' || sym == '\t' || sym == '\v' || sym == '\f';
         }
-        
-        /// @brief arguments long name.
-        /// for non positional arguments only
-        /// argument long name start with double prefix
-        std::string m_longName = "";
 
-        /// @brief Handy setter for long named argument. 
-        /// Should been used with double prefix in command line.
-        /// Can be used for auto-generation of short name if it possible
-        /// and m_allowAbbrev in ArgymentParsed is "true".
-        /// @param name name for positional argument. Empty by default
-        /// @return reference to current argument
-        Argument& SetLongName(const std::string& name)
+        /// @brief Read only contents of whole file, read into buffer
+        /// or memory mapped if ARGPARSE_USE_MMAP is defined
+        class FileContents
         {
-            m_longName = name;
-            return *this;
-        }
+        public:
+            FileContents() {}
 
-        /// @brief additional help info for argument
+            FileContents(const FileContents&) = delete;
+            FileContents& operator=(const FileContents&) = delete;
+
+            ~FileContents()
+            {
+                Close();
+            }
+
+            /// @brief Reads or maps file to memory
+            /// @param path path to file
+            /// @return false if file cannot be opened, read or mapped
+            bool Open(const std::string& path)
+            {
+                Close();
+#ifndef ARGPARSE_USE_MMAP
+                std::ifstream file(path, std::ios::in | std::ios::binary);
+                if (!file)
+                {
+                    return false;
+                }
+                // read by chunks until end, size reported by stream is not reliable for non regular files
+                char chunk[1 << 16];
+                while (file.read(chunk, sizeof(chunk)) || file.gcount() > 0)
+                {
+                    m_buffer.append(chunk, static_cast<size_t>(file.gcount()));
+                }
+                if (file.bad())
+                {
+                    m_buffer.clear();
+                    return false;
+                }
+                m_path = path;
+                m_data = m_buffer.data();
+                m_size = m_buffer.size();
+#elif defined(_WIN32)
+                m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                if (m_file == INVALID_HANDLE_VALUE)
+                {
+                    return false;
+                }
+                BY_HANDLE_FILE_INFORMATION info;
+                if (!GetFileInformationByHandle(m_file, &info))
+                {
+                    Close();
+                    return false;
+                }
+                m_device = info.dwVolumeSerialNumber;
+                m_index = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+                m_size = static_cast<size_t>((static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow);
+                if (m_size == 0)
+                {
+                    return true;
+                }
+                m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (m_mapping == nullptr)
+                {
+                    Close();
+                    return false;
+                }
+                m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+                if (m_data == nullptr)
+                {
+                    Close();
+                    return false;
+                }
+#else
+                const int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0)
+                {
+                    return false;
+                }
+                struct stat info;
+                if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+                {
+                    ::close(fd);
+                    return false;
+                }
+                m_device = static_cast<uint64_t>(info.st_dev);
+                m_index = static_cast<uint64_t>(info.st_ino);
+                m_size = static_cast<size_t>(info.st_size);
+                if (m_size == 0)
+                {
+                    ::close(fd);
+                    return true;
+                }
+                void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+                if (data == MAP_FAILED)
+                {
+                    m_size = 0;
+                    return false;
+                }
+                ::madvise(data, m_size, MADV_SEQUENTIAL);
+                m_data = static_cast<const char*>(data);
+#endif
+                return true;
+            }
+
+            void Close() noexcept
+            {
+#ifndef ARGPARSE_USE_MMAP
+                m_buffer.clear();
+                m_path.clear();
+#elif defined(_WIN32)
+                if (m_data != nullptr)
+                {
+                    UnmapViewOfFile(m_data);
+                }
+                if (m_mapping != nullptr)
+                {
+                    CloseHandle(m_mapping);
+                    m_mapping = nullptr;
+                }
+                if (m_file != INVALID_HANDLE_VALUE)
+                {
+                    CloseHandle(m_file);
+                    m_file = INVALID_HANDLE_VALUE;
+                }
+#else
+                if (m_data != nullptr)
+                {
+                    ::munmap(const_cast<char*>(m_data), m_size);
+                }
+#endif
+                m_data = nullptr;
+                m_size = 0;
+            }
+
+            const char* Data() const noexcept
+            {
+                return m_data;
+            }
+
+            size_t Size() const noexcept
+            {
+                return m_size;
+            }
+
+            /// @brief Checks if both contents are of the same file. Mapped files are
+            /// compared by identity even if paths differ, read files are compared by path.
+            bool IsSameFile(const FileContents& other) const noexcept
+            {
+#ifdef ARGPARSE_USE_MMAP
+                return m_device == other.m_device && m_index == other.m_index;
+#else
+                return m_path == other.m_path;
+#endif
+            }
+
+        private:
+            const char* m_data = nullptr;
+            size_t      m_size = 0;
+#ifndef ARGPARSE_USE_MMAP
+            std::string m_buffer;
+            std::string m_path;
+#else
+            /// @brief device and inode (volume and file index on Windows), identity of file
+            uint64_t    m_device = 0;
+            uint64_t    m_index = 0;
+#ifdef _WIN32
+            HANDLE      m_file = INVALID_HANDLE_VALUE;
+            HANDLE      m_mapping = nullptr;
+#endif
+#endif
+        };
+
+        /// @brief Token source which expands "@file" tokens of other source into whitespace separated
+        /// tokens of file. Tokens are views into contents of files, so files are kept
+        /// in memory until source is destroyed. Nested files are supported,
+        /// file which includes itself (directly or through other files) is an error.
+        /// @tparam TokenSource class with functions bool Next(StringView&), bool HasError() and GetError()
+        template<typename TokenSource>
+        class ResponseFileTokens
+        {
+        public:
+            /// @param tokens source of input tokens
+            /// @param prefix character which marks response file, e.g. '@'
+            ResponseFileTokens(TokenSource& tokens, char prefix)
+                : m_tokens(tokens)
+                , m_prefix(prefix)
+            {}
+
+            /// @brief Function to take next token
+            /// @param token out parameter, view of next token
+            /// @return false if input is over or response file cannot be read
+            bool Next(StringView& token)
+            {
+                while (m_error.empty())
+                {
+                    if (m_stack.empty())
+                    {
+                        if (!m_tokens.Next(token))
+                        {
+                            return false;
+                        }
+                    }
+                    else if (!_scan(m_stack.back(), token))
+                    {
+                        m_stack.pop_back();
+                        continue;
+                    }
+
+                    if (token.size() > 1 && token[0] == m_prefix)
+                    {
+                        _open(std::string(token.data() + 1, token.size() - 1));
+                        continue;
+                    }
+                    return true;
+                }
+                return false;
+            }
+
+            bool HasError() const noexcept
+            {
+                return !m_error.empty() || m_tokens.HasError();
+            }
+
+            const std::string& GetError() const
+            {
+                return m_error.empty() ? m_tokens.GetError() : m_error;
+            }
+
+        private:
+            /// @brief Position of reading in one of opened files
+            struct Cursor
+            {
+                const FileContents* file;
+                size_t            offset;
+            };
+
+            /// @brief Takes next whitespace separated token of file
+            bool _scan(Cursor& cursor, StringView& token)
+            {
+                const char* data = cursor.file->Data();
+                const size_t size = cursor.file->Size();
+                size_t offset = cursor.offset;
+                while (offset < size && isSpace(data[offset]))
+                {
+                    ++offset;
+                }
+                const size_t first = offset;
+                while (offset < size && !isSpace(data[offset]))
+                {
+                    ++offset;
+                }
+                cursor.offset = offset;
+                if (first == offset)
+                {
+                    return false;
+                }
+                token = StringView(data + first, offset - first);
+                return true;
+            }
+
+            void _open(const std::string& path)
+            {
+                // files are compared by path unless they are mapped, so limit nesting
+                // to stop on file which includes itself through other path
+                if (m_stack.size() >= kMaxDepth)
+                {
+                    m_error = "Arguments files are nested too deep at \"" + path + "\"";
+                    return;
+                }
+                std::unique_ptr<FileContents> file(new FileContents());
+                if (!file->Open(path))
+                {
+                    m_error = "Cannot read arguments file \"" + path + "\"";
+                    return;
+                }
+                for (const Cursor& cursor : m_stack)
+                {
+                    if (cursor.file->IsSameFile(*file))
+                    {
+                        m_error = "Arguments file \"" + path + "\" includes itself";
+                        return;
+                    }
+                }
+                m_stack.push_back({ file.get(), 0 });
+                m_files.push_back(std::move(file));
+            }
+
+            static const size_t kMaxDepth = 64;
+
+            TokenSource&    m_tokens;
+            char            m_prefix;
+            /// @brief files which are being read, innermost is last
+            std::vector<Cursor> m_stack;
+            /// @brief all files opened while parsing, tokens point into them
+            std::vector<std::unique_ptr<FileContents>> m_files;
+            std::string     m_error;
+        };
+
+        /// @brief Token source which splits one command line string by POSIX shell rules:
+        /// whitespace separates tokens, backslash escapes next character, single quotes keep text as is,
+        /// double quotes keep text except of backslash escapes of $ ` " backslash and newline.
+        /// Plain tokens are views into command line, only tokens with quotes or escapes are copied.
+        class CommandLineTokens
+        {
+        public:
+            /// @param commandLine command line, must be alive until parsing ends
+            explicit CommandLineTokens(StringView commandLine)
+                : m_input(commandLine)
+            {}
+
+            /// @brief Function to take next token
+            /// @param token out parameter, view of next token
+            /// @return false if input is over or quotes are not closed
+            bool Next(StringView& token)
+            {
+                const char* data = m_input.data();
+                const size_t size = m_input.size();
+                while (m_offset < size && (isSpace(data[m_offset]) || _isLineContinuation(m_offset)))
+                {
+                    m_offset += data[m_offset] == '\\' ? 2 : 1;
+                }
+                if (m_offset >= size || !m_error.empty())
+                {
+                    return false;
+                }
+
+                const size_t first = m_offset;
+                while (m_offset < size && !isSpace(data[m_offset]) && !_isQuoting(data[m_offset]))
+                {
+                    ++m_offset;
+                }
+                if (m_offset == size || isSpace(data[m_offset]))
+                {
+                    token = StringView(data + first, m_offset - first);
+                    return true;
+                }
+
+                std::string unescaped(data + first, m_offset - first);
+                if (!_unescape(unescaped))
+                {
+                    return false;
+                }
+                m_unescaped.push_back(std::move(unescaped));
+                token = StringView(m_unescaped.back());
+                return true;
+            }
+
+            bool HasError() const noexcept
+            {
+                return !m_error.empty();
+            }
+
+            const std::string& GetError() const
+            {
+                return m_error;
+            }
+
+        private:
+            static bool _isQuoting(char sym) noexcept
+            {
+                return sym == '\\' || sym == '\'' || sym == '"';
+            }
+
+            static bool _isEscapedInDoubleQuotes(char sym) noexcept
+            {
+                return sym == '$' || sym == '`' || sym == '"' || sym == '\\' || sym == '\n';
+            }
+
+            bool _isLineContinuation(size_t offset) const noexcept
+            {
+                return m_input[offset] == '\\' && offset + 1 < m_input.size() && m_input[offset + 1] == '\n';
+            }
+
+            /// @brief Reads rest of token with quotes and escapes
+            /// @param out token text, already contains plain part of token
+            /// @return false if quote is not closed or line ends with escape character
+            bool _unescape(std::string& out)
+            {
+                const char* data = m_input.data();
+                const size_t size = m_input.size();
+                while (m_offset < size && !isSpace(data[m_offset]))
+                {
+                    const char sym = data[m_offset];
+                    if (sym == '\\')
+                    {
+                        if (m_offset + 1 == size)
+                        {
+                            m_error = "Command line ends with escape character";
+                            return false;
+                        }
+                        if (data[m_offset + 1] != '\n')
+                        {
+                            out.push_back(data[m_offset + 1]);
+                        }
+                        m_offset += 2;
+                    }
+                    else if (sym == '\'')
+                    {
+                        const void* closing = std::memchr(data + m_offset + 1, '\'', size - m_offset - 1);
+                        if (closing == nullptr)
+                        {
+                            m_error = "Unterminated single quote in command line";
+                            return false;
+                        }
+                        const size_t closingOffset = static_cast<size_t>(static_cast<const char*>(closing) - data);
+                        out.append(data + m_offset + 1, closingOffset - m_offset - 1);
+                        m_offset = closingOffset + 1;
+                    }
+                    else if (sym == '"')
+                    {
+                        ++m_offset;
+                        while (m_offset < size && data[m_offset] != '"')
+                        {
+                            if (data[m_offset] == '\\' && m_offset + 1 < size && _isEscapedInDoubleQuotes(data[m_offset + 1]))
+                            {
+                                if (data[m_offset + 1] != '\n')
+                                {
+                                    out.push_back(data[m_offset + 1]);
+                                }
+                                m_offset += 2;
+                                continue;
+                            }
+                            out.push_back(data[m_offset]);
+                            ++m_offset;
+                        }
+                        if (m_offset == size)
+                        {
+                            m_error = "Unterminated double quote in command line";
+                            return false;
+                        }
+                        ++m_offset;
+                    }
+                    else
+                    {
+                        out.push_back(sym);
+                        ++m_offset;
+                    }
+                }
+                return true;
+            }
+
+            StringView m_input;
+            size_t     m_offset = 0;
+            /// @brief tokens with quotes or escapes, deque keeps views into them valid
+            std::deque<std::string> m_unescaped;
+            std::string m_error;
+        };
+
+        /// @brief Result of conversion of token to number
+        enum class ConversionResult : int
+        {
+            e_Ok,
+            e_Invalid,
+            e_OutOfRange
+        };
+
+        /// @brief Single pass conversion of whole token to integer without exceptions.
+        /// Accepts optional minus sign and decimal digits only.
+        /// @tparam T int or long long
+        /// @param token input token
+        /// @param value out parameter, set only on success
+        /// @return e_Ok, e_Invalid for malformed input, e_OutOfRange for overflow
+        template<typename T>
+        ConversionResult parseInteger(StringView token, T& value) noexcept
+        {
+            const char* first = token.data();
+            const char* last = first + token.size();
+#ifdef ARGPARSE_HAS_CXX17
+            T result = 0;
+            const std::from_chars_result converted = std::from_chars(first, last, result);
+            if (converted.ec == std::errc::result_out_of_range)
+            {
+                return ConversionResult::e_OutOfRange;
+            }
+            if (converted.ec != std::errc() || converted.ptr != last)
+            {
+                return ConversionResult::e_Invalid;
+            }
+            value = result;
+            return ConversionResult::e_Ok;
+#else
+            const bool negative = first != last && *first == '-';
+            if (negative)
+            {
+                ++first;
+            }
+            if (first == last)
+            {
+                return ConversionResult::e_Invalid;
+            }
+
+            // accumulate in negative range, it is wider than positive one
+            const T lowest = std::numeric_limits<T>::min();
+            T result = 0;
+            for (; first != last; ++first)
+            {
+                if (*first < '0' || *first > '9')
+                {
+                    return ConversionResult::e_Invalid;
+                }
+                const T digit = static_cast<T>(*first - '0');
+                if (result < (lowest + digit) / 10)
+                {
+                    return ConversionResult::e_OutOfRange;
+                }
+                result = result * 10 - digit;
+            }
+            if (!negative)
+            {
+                if (result == lowest)
+                {
+                    return ConversionResult::e_OutOfRange;
+                }
+                result = -result;
+            }
+            value = result;
+            return ConversionResult::e_Ok;
+#endif // ARGPARSE_HAS_CXX17
+        }
+
+        /// @brief Checks syntax of integer accepted by parseInteger without converting it:
+        /// optional minus sign and at least one decimal digit. Range is not checked.
+        inline bool isIntegerSyntax(StringView token) noexcept
+        {
+            const size_t first = !token.empty() && token[0] == '-' ? 1 : 0;
+            if (first == token.size())
+            {
+                return false;
+            }
+            for (size_t i = first; i < token.size(); ++i)
+            {
+                if (token[i] < '0' || token[i] > '9')
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// @brief Conversion of whole token to double without exceptions. Uses std::from_chars
+        /// if standard library supports it for floating point, otherwise strtod over copy of token
+        /// with terminating zero, which stays on stack for tokens shorter than 64 characters.
+        /// @param token input token
+        /// @param value out parameter, set only on success
+        /// @return e_Ok, e_Invalid for malformed input, e_OutOfRange for overflow or underflow
+        inline ConversionResult parseDouble(StringView token, double& value)
+        {
+            if (token.empty())
+            {
+                return ConversionResult::e_Invalid;
+            }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            const char* last = token.data() + token.size();
+            double result = 0;
+            const std::from_chars_result converted = std::from_chars(token.data(), last, result);
+            if (converted.ec == std::errc::result_out_of_range)
+            {
+                return ConversionResult::e_OutOfRange;
+            }
+            if (converted.ec != std::errc() || converted.ptr != last)
+            {
+                return ConversionResult::e_Invalid;
+            }
+            value = result;
+            return ConversionResult::e_Ok;
+#else
+            char buffer[64];
+            std::string longToken;
+            const char* text = buffer;
+            if (token.size() < sizeof(buffer))
+            {
+                std::memcpy(buffer, token.data(), token.size());
+                buffer[token.size()] = '\0';
+            }
+            else
+            {
+                longToken.assign(token.data(), token.size());
+                text = longToken.c_str();
+            }
+            errno = 0;
+            char* end = nullptr;
+            const double result = std::strtod(text, &end);
+            if (end != text + token.size())
+            {
+                return ConversionResult::e_Invalid;
+            }
+            if (errno == ERANGE)
+            {
+                return ConversionResult::e_OutOfRange;
+            }
+            value = result;
+            return ConversionResult::e_Ok;
+#endif
+        }
+
+        /// @brief Atomic flag which can be copied, copy takes current value,
+        /// so class which keeps it can use default copy and move
+        class CopyableAtomicFlag
+        {
+        public:
+            CopyableAtomicFlag() noexcept
+                : m_value(false)
+            {}
+
+            CopyableAtomicFlag(const CopyableAtomicFlag& other) noexcept
+                : m_value(other.Load())
+            {}
+
+            CopyableAtomicFlag& operator=(const CopyableAtomicFlag& other) noexcept
+            {
+                Store(other.Load());
+                return *this;
+            }
+
+            bool Load() const noexcept
+            {
+                return m_value.load(std::memory_order_acquire);
+            }
+
+            void Store(bool value) noexcept
+            {
+                m_value.store(value, std::memory_order_release);
+            }
+
+        private:
+            std::atomic<bool> m_value;
+        };
+
+        /// @brief Finalizer of splitmix64, spreads bits of input over whole word
+        inline uint64_t mixBits(uint64_t value) noexcept
+        {
+            value ^= value >> 30;
+            value *= 0xbf58476d1ce4e5b9ULL;
+            value ^= value >> 27;
+            value *= 0x94d049bb133111ebULL;
+            value ^= value >> 31;
+            return value;
+        }
+
+        /// @brief Seeded hash of bytes, reads input by 8 bytes words
+        inline uint64_t hashBytes(const char* data, size_t size, uint64_t seed) noexcept
+        {
+            uint64_t hash = seed ^ (static_cast<uint64_t>(size) * 0x9e3779b97f4a7c15ULL);
+            while (size >= sizeof(uint64_t))
+            {
+                uint64_t word;
+                std::memcpy(&word, data, sizeof(word));
+                hash = (hash ^ word) * 0x9e3779b97f4a7c15ULL;
+                hash ^= hash >> 29;
+                data += sizeof(word);
+                size -= sizeof(word);
+            }
+            if (size)
+            {
+                uint64_t word = 0;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    word |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+                }
+                hash = (hash ^ word) * 0x9e3779b97f4a7c15ULL;
+            }
+            return mixBits(hash);
+        }
+
+        /// @brief Environment of process as null terminated array of "NAME=VALUE" strings
+        inline char** environment() noexcept
+        {
+#if defined(_WIN32)
+            return _environ;
+#elif defined(__APPLE__)
+            return *_NSGetEnviron();
+#else
+            return environ;
+#endif
+        }
+
+        /// @brief Maps 32 bit value to range [0, range) without division
+        inline size_t reduceToRange(uint64_t value, size_t range) noexcept
+        {
+            return static_cast<size_t>(((value & 0xffffffffULL) * static_cast<uint64_t>(range)) >> 32);
+        }
+
+        /// @brief Static minimal perfect hash (CHD scheme) from strings to positions.
+        /// Built once for fixed set of keys, lookup is one hash,
+        /// one displacement read and one memcmp.
+        class PerfectHashIndex
+        {
+        public:
+            /// @brief value returned by Find for unknown keys
+            static const size_t kNotFound = static_cast<size_t>(-1);
+
+            /// @brief Function to build index. Keys must be unique.
+            /// @param keys vector of key and value pairs
+            void Build(const std::vector<std::pair<std::string, size_t>>& keys)
+            {
+                m_keys.clear();
+                m_entries.assign(keys.size(), Entry());
+                m_displacements.clear();
+                if (keys.empty())
+                {
+                    return;
+                }
+
+                const size_t keysCount = keys.size();
+                const size_t bucketsCount = keysCount / kAverageBucketSize + 1;
+                const uint32_t maxDisplacement = 1u << 20;
+                std::vector<uint64_t> hashes(keysCount);
+                std::vector<std::vector<size_t>> buckets;
+                std::vector<char> occupied;
+                std::vector<size_t> slots;
+
+                for (m_seed = 0;; ++m_seed)
+                {
+                    for (size_t i = 0; i < keysCount; ++i)
+                    {
+                        hashes[i] = hashBytes(keys[i].first.data(), keys[i].first.size(), m_seed);
+                    }
+
+                    buckets.assign(bucketsCount, std::vector<size_t>());
+                    for (size_t i = 0; i < keysCount; ++i)
+                    {
+                        buckets[reduceToRange(hashes[i] >> 32, bucketsCount)].push_back(i);
+                    }
+
+                    std::vector<size_t> order(bucketsCount);
+                    for (size_t i = 0; i < bucketsCount; ++i)
+                    {
+                        order[i] = i;
+                    }
+                    std::stable_sort(order.begin(), order.end(), [&buckets](size_t lhs, size_t rhs) -> bool
+                        {
+                            return buckets[lhs].size() > buckets[rhs].size();
+                        });
+
+                    m_displacements.assign(bucketsCount, 0);
+                    occupied.assign(keysCount, 0);
+                    bool succeeded = true;
+                    for (size_t bucketIndex : order)
+                    {
+                        const std::vector<size_t>& bucket = buckets[bucketIndex];
+                        if (bucket.empty())
+                        {
+                            break;
+                        }
+
+                        uint32_t displacement = 1;
+                        for (; displacement < maxDisplacement; ++displacement)
+                        {
+                            slots.clear();
+                            for (size_t keyIndex : bucket)
+                            {
+                                const size_t slot = SlotFor(hashes[keyIndex], displacement, keysCount);
+                                if (occupied[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end())
+                                {
+                                    break;
+                                }
+                                slots.push_back(slot);
+                            }
+                            if (slots.size() == bucket.size())
+                            {
+                                break;
+                            }
+                        }
+                        if (displacement == maxDisplacement)
+                        {
+                            succeeded = false;
+                            break;
+                        }
+
+                        m_displacements[bucketIndex] = displacement;
+                        for (size_t i = 0; i < bucket.size(); ++i)
+                        {
+                            occupied[slots[i]] = 1;
+                            m_entries[slots[i]].keyIndex = bucket[i];
+                        }
+                    }
+
+                    if (succeeded)
+                    {
+                        break;
+                    }
+                }
+
+                // keys are stored in one buffer in slots order to keep lookup cache friendly
+                std::vector<Entry> entries(m_entries);
+                for (size_t slot = 0; slot < keysCount; ++slot)
+                {
+                    const std::pair<std::string, size_t>& key = keys[entries[slot].keyIndex];
+                    m_entries[slot].offset = m_keys.size();
+                    m_entries[slot].size = key.first.size();
+                    m_entries[slot].value = key.second;
+                    m_keys += key.first;
+                }
+            }
+
+            /// @brief Function to find value by key
+            /// @param key searched key
+            /// @return value of key or kNotFound
+            size_t Find(StringView key) const noexcept
+            {
+                if (m_entries.empty())
+                {
+                    return kNotFound;
+                }
+                const uint64_t hash = hashBytes(key.data(), key.size(), m_seed);
+                const uint32_t displacement = m_displacements[reduceToRange(hash >> 32, m_displacements.size())];
+                const Entry& entry = m_entries[SlotFor(hash, displacement, m_entries.size())];
+                if (entry.size != key.size() || std::memcmp(m_keys.data() + entry.offset, key.data(), key.size()) != 0)
+                {
+                    return kNotFound;
+                }
+                return entry.value;
+            }
+
+            /// @brief count of keys in index
+            size_t Size() const noexcept
+            {
+                return m_entries.size();
+            }
+
+        private:
+            static const size_t kAverageBucketSize = 3;
+
+            static size_t SlotFor(uint64_t hash, uint32_t displacement, size_t range) noexcept
+            {
+                return reduceToRange(((hash ^ displacement) * 0xbf58476d1ce4e5b9ULL) >> 32, range);
+            }
+
+            struct Entry
+            {
+                size_t keyIndex = 0;
+                size_t offset = 0;
+                size_t size = 0;
+                size_t value = 0;
+            };
+
+            uint64_t              m_seed = 0;
+            std::string           m_keys;
+            std::vector<Entry>    m_entries;
+            std::vector<uint32_t> m_displacements;
+        };
+
+        /// @brief Sorted array of keys for lookup by unambiguous prefix.
+        /// Lookup is one binary search: matches of a prefix are adjacent in sorted order,
+        /// so prefix is unique if the next key after the first match doesn't match it.
+        class PrefixIndex
+        {
+        public:
+            /// @brief value returned by Find if no key starts with prefix
+            static const size_t kNotFound = static_cast<size_t>(-1);
+            /// @brief value returned by Find if several keys start with prefix
+            static const size_t kAmbiguous = static_cast<size_t>(-2);
+
+            /// @brief Function to build index. Keys must be unique.
+            /// @param keys vector of key and value pairs
+            void Build(std::vector<std::pair<std::string, size_t>> keys)
+            {
+                std::sort(keys.begin(), keys.end());
+                m_keys.clear();
+                m_entries.clear();
+                m_entries.reserve(keys.size());
+                for (const std::pair<std::string, size_t>& key : keys)
+                {
+                    m_entries.push_back({ m_keys.size(), key.first.size(), key.second });
+                    m_keys += key.first;
+                }
+            }
+
+            /// @brief Function to find value of the only key which starts with prefix
+            /// @param prefix searched prefix
+            /// @return value of key, kNotFound or kAmbiguous
+            size_t Find(StringView prefix) const noexcept
+            {
+                const size_t first = LowerBound(prefix);
+                if (first == m_entries.size() || !StartsWith(first, prefix))
+                {
+                    return kNotFound;
+                }
+                if (first + 1 < m_entries.size() && StartsWith(first + 1, prefix))
+                {
+                    return kAmbiguous;
+                }
+                return m_entries[first].value;
+            }
+
+            /// @brief Function to list all keys which start with prefix, used to report ambiguity
+            /// @param prefix searched prefix
+            /// @return keys in sorted order
+            std::vector<StringView> Matches(StringView prefix) const
+            {
+                std::vector<StringView> matches;
+                for (size_t i = LowerBound(prefix); i < m_entries.size() && StartsWith(i, prefix); ++i)
+                {
+                    matches.push_back(Key(i));
+                }
+                return matches;
+            }
+
+            /// @brief count of keys in index
+            size_t Size() const noexcept
+            {
+                return m_entries.size();
+            }
+
+        private:
+            struct Entry
+            {
+                size_t offset;
+                size_t size;
+                size_t value;
+            };
+
+            StringView Key(size_t index) const noexcept
+            {
+                return StringView(m_keys.data() + m_entries[index].offset, m_entries[index].size);
+            }
+
+            bool StartsWith(size_t index, StringView prefix) const noexcept
+            {
+                const Entry& entry = m_entries[index];
+                return entry.size >= prefix.size() && std::memcmp(m_keys.data() + entry.offset, prefix.data(), prefix.size()) == 0;
+            }
+
+            /// @brief index of first key which is not less than prefix
+            size_t LowerBound(StringView prefix) const noexcept
+            {
+                size_t first = 0;
+                size_t count = m_entries.size();
+                while (count > 0)
+                {
+                    const size_t half = count / 2;
+                    const Entry& entry = m_entries[first + half];
+                    const int compared = std::memcmp(m_keys.data() + entry.offset, prefix.data(), std::min(entry.size, prefix.size()));
+                    if (compared < 0 || (compared == 0 && entry.size < prefix.size()))
+                    {
+                        first += half + 1;
+                        count -= half + 1;
+                    }
+                    else
+                    {
+                        count = half;
+                    }
+                }
+                return first;
+            }
+
+            std::string        m_keys;
+            std::vector<Entry> m_entries;
+        };
+
+        /// @brief Set of names to suggest the closest ones for mistyped token.
+        /// Distance is Levenshtein one computed by bit-parallel algorithm of Myers
+        /// (formulation of Hyyrö): token is a pattern of up to 64 characters
+        /// and each character of name costs few word operations.
+        /// Names are sorted, so state computed for common prefix of neighbour names
+        /// is reused like in a walk over trie, and once no name with some prefix can be
+        /// within allowed distance all of them are skipped by one binary search.
+        /// Names which length differs from token too much are skipped without computation.
+        class SuggestionIndex
+        {
+        public:
+            /// @brief longest token which suggestions are searched for
+            static const size_t kMaxPatternSize = 64;
+
+            /// @brief Function to build index
+            /// @param names names to suggest
+            void Build(std::vector<std::string> names)
+            {
+                std::sort(names.begin(), names.end());
+                m_names = std::move(names);
+            }
+
+            /// @brief Function to find names closest to token
+            /// @param token mistyped token
+            /// @param maxDistance names which are farther from token are not suggested
+            /// @param maxCount maximal count of suggestions
+            /// @return names with minimal distance to token in alphabetical order
+            std::vector<StringView> Suggest(StringView token, size_t maxDistance, size_t maxCount) const
+            {
+                std::vector<StringView> suggestions;
+                if (token.empty() || token.size() > kMaxPatternSize || maxCount == 0)
+                {
+                    return suggestions;
+                }
+
+                uint64_t peq[256] = {};
+                for (size_t i = 0; i < token.size(); ++i)
+                {
+                    peq[static_cast<unsigned char>(token[i])] |= uint64_t(1) << i;
+                }
+                const uint64_t last = uint64_t(1) << (token.size() - 1);
+
+                // states[j] is column of distance matrix after first j characters of previous name
+                std::vector<State> states;
+                states.reserve(kMaxPatternSize + 1);
+                states.push_back({ ~uint64_t(0), 0, token.size() });
+                const std::string* previous = nullptr;
+                size_t best = maxDistance;
+                for (size_t index = 0; index < m_names.size(); ++index)
+                {
+                    const std::string& name = m_names[index];
+                    if ((name.size() > token.size() ? name.size() - token.size() : token.size() - name.size()) > best)
+                    {
+                        continue;
+                    }
+
+                    size_t common = 0;
+                    if (previous != nullptr)
+                    {
+                        const size_t limit = std::min(name.size(), states.size() - 1);
+                        while (common < limit && (*previous)[common] == name[common])
+                        {
+                            ++common;
+                        }
+                    }
+                    states.resize(common + 1);
+                    previous = &name;
+
+                    size_t deadPrefix = 0;
+                    for (size_t j = common; j < name.size(); ++j)
+                    {
+                        State state = states.back();
+                        Step(state, peq[static_cast<unsigned char>(name[j])], last);
+                        states.push_back(state);
+                        if (ColumnMin(state, j + 1, token.size()) > best)
+                        {
+                            deadPrefix = j + 1;
+                            break;
+                        }
+                    }
+                    if (deadPrefix != 0)
+                    {
+                        // names with the same prefix are next to each other, skip them all
+                        index = std::partition_point(m_names.begin() + index, m_names.end(), [&name, deadPrefix](const std::string& other) -> bool
+                            {
+                                return other.compare(0, deadPrefix, name, 0, deadPrefix) == 0;
+                            }) - m_names.begin() - 1;
+                        continue;
+                    }
+                    const size_t distance = states.back().score;
+                    if (distance > best)
+                    {
+                        continue;
+                    }
+                    if (distance < best)
+                    {
+                        best = distance;
+                        suggestions.clear();
+                    }
+                    if (suggestions.size() < maxCount)
+                    {
+                        suggestions.push_back(StringView(name.data(), name.size()));
+                    }
+                }
+                return suggestions;
+            }
+
+            /// @brief count of names in index
+            size_t Size() const noexcept
+            {
+                return m_names.size();
+            }
+
+        private:
+            /// @brief Column of distance matrix encoded as vertical deltas
+            struct State
+            {
+                uint64_t pv;
+                uint64_t mv;
+                size_t   score;
+            };
+
+            /// @brief Computes next column of distance matrix
+            /// @param state column to update, score is distance between token and processed text
+            /// @param eq mask of token positions equal to next character of text
+            /// @param last mask of last position of token
+            static void Step(State& state, uint64_t eq, uint64_t last) noexcept
+            {
+                const uint64_t xv = eq | state.mv;
+                const uint64_t xh = (((eq & state.pv) + state.pv) ^ state.pv) | eq;
+                uint64_t ph = state.mv | ~(xh | state.pv);
+                uint64_t mh = state.pv & xh;
+                if (ph & last)
+                {
+                    ++state.score;
+                }
+                else if (mh & last)
+                {
+                    --state.score;
+                }
+                ph = (ph << 1) | 1;
+                mh <<= 1;
+                state.pv = mh | ~(xv | ph);
+                state.mv = ph & xv;
+            }
+
+            /// @brief Minimal value in column of distance matrix. Any path of alignment crosses
+            /// every column, so distance of any name with processed prefix is not less than it.
+            /// @param state column of distance matrix
+            /// @param column count of processed characters of text, value in top row of matrix
+            /// @param patternSize length of token
+            static size_t ColumnMin(const State& state, size_t column, size_t patternSize) noexcept
+            {
+                size_t value = column;
+                size_t minimum = column;
+                for (size_t i = 0; i < patternSize; ++i)
+                {
+                    if ((state.pv >> i) & 1)
+                    {
+                        ++value;
+                    }
+                    else if ((state.mv >> i) & 1)
+                    {
+                        --value;
+                        minimum = std::min(minimum, value);
+                    }
+                }
+                return minimum;
+            }
+
+            std::vector<std::string> m_names;
+        };
+
+        /// @brief Reader of configuration files for ArgumentParser::AddConfigFile.
+        /// Collects values of keys which are long names of arguments as views into file text,
+        /// all other keys and sections are skipped without allocations.
+        /// Only strings with escape sequences are copied to unescape them.
+        class ConfigReader
+        {
+        public:
+            /// @param names index of long names of arguments (without prefix) to argument index
+            /// @param values values per argument index, filled by reader. Later values of same key replace earlier ones
+            /// @param strings storage for unescaped strings, deque keeps views into them valid
+            ConfigReader(const PerfectHashIndex& names, std::vector<std::vector<StringView>>& values, std::deque<std::string>& strings)
+                : m_names(names)
+                , m_values(values)
+                , m_strings(strings)
+            {}
+
+            /// @brief Reads INI file or TOML subset: [section] headers, key = value lines,
+            /// # and ; comments, "quoted" and 'literal' strings and one line [arrays]
+            /// @param text text of file
+            /// @param section section to take keys from, empty for keys before first section header
+            /// @return false if file has syntax error, see GetError
+            bool ReadIni(StringView text, StringView section)
+            {
+                m_text = text;
+                bool inSection = section.empty();
+                size_t offset = 0;
+                while (offset < text.size())
+                {
+                    const void* found = std::memchr(text.data() + offset, '\n', text.size() - offset);
+                    const size_t lineEnd = found == nullptr ? text.size() : static_cast<size_t>(static_cast<const char*>(found) - text.data());
+                    const StringView line = _trim(StringView(text.data() + offset, lineEnd - offset));
+                    offset = lineEnd + 1;
+
+                    if (line.empty() || line[0] == '#' || line[0] == ';')
+                    {
+                        continue;
+                    }
+                    if (line[0] == '[')
+                    {
+                        if (line[line.size() - 1] != ']')
+                        {
+                            return _fail(line.data(), "expected ] at the end of section header");
+                        }
+                        inSection = _trim(StringView(line.data() + 1, line.size() - 2)) == section;
+                        continue;
+                    }
+                    if (!inSection)
+                    {
+                        continue;
+                    }
+
+                    size_t equal = 0;
+                    while (equal < line.size() && line[equal] != '=')
+                    {
+                        ++equal;
+                    }
+                    if (equal == line.size())
+                    {
+                        return _fail(line.data(), "expected key = value");
+                    }
+                    const size_t position = m_names.Find(_trim(StringView(line.data(), equal)));
+                    if (position == PerfectHashIndex::kNotFound)
+                    {
+                        continue;
+                    }
+                    std::vector<StringView>& values = m_values[position];
+                    values.clear();
+                    if (!_iniValue(line, equal + 1, values))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /// @brief Reads JSON file with one object on top level. Values could be strings, numbers,
+            /// true, false, null (value is skipped) and arrays of them.
+            /// @param text text of file
+            /// @param section key of nested object to take keys from, empty for keys of top level object
+            /// @return false if file has syntax error, see GetError
+            bool ReadJson(StringView text, StringView section)
+            {
+                m_text = text;
+                size_t offset = _skipJsonSpaces(0);
+                if (offset == text.size() || text[offset] != '{')
+                {
+                    return _fail(text.data() + offset, "expected object");
+                }
+                if (!_jsonObject(offset, section))
+                {
+                    return false;
+                }
+                offset = _skipJsonSpaces(offset);
+                if (offset != text.size())
+                {
+                    return _fail(text.data() + offset, "unexpected text after object");
+                }
+                return true;
+            }
+
+            const std::string& GetError() const
+            {
+                return m_error;
+            }
+
+        private:
+            static StringView _trim(StringView text) noexcept
+            {
+                size_t first = 0;
+                size_t last = text.size();
+                while (first < last && isSpace(text[first]))
+                {
+                    ++first;
+                }
+                while (last > first && isSpace(text[last - 1]))
+                {
+                    --last;
+                }
+                return StringView(text.data() + first, last - first);
+            }
+
+            static size_t _skipBlanks(StringView text, size_t offset) noexcept
+            {
+                while (offset < text.size() && isSpace(text[offset]))
+                {
+                    ++offset;
+                }
+                return offset;
+            }
+
+            bool _fail(const char* where, const char* message)
+            {
+                size_t line = 1;
+                for (const char* it = m_text.data(); it < where; ++it)
+                {
+                    line += *it == '\n';
+                }
+                m_error = "at line " + std::to_string(line) + ": " + message;
+                return false;
+            }
+
+            /// @brief Parses value of INI line: single item or one line array
+            bool _iniValue(StringView line, size_t offset, std::vector<StringView>& values)
+            {
+                offset = _skipBlanks(line, offset);
+                StringView item;
+                if (offset < line.size() && line[offset] == '[')
+                {
+                    offset = _skipBlanks(line, offset + 1);
+                    while (offset == line.size() || line[offset] != ']')
+                    {
+                        if (offset == line.size())
+                        {
+                            return _fail(line.data(), "expected ] at the end of array");
+                        }
+                        if (!_iniItem(line, offset, ",]", item))
+                        {
+                            return false;
+                        }
+                        values.push_back(item);
+                        offset = _skipBlanks(line, offset);
+                        if (offset < line.size() && line[offset] == ',')
+                        {
+                            offset = _skipBlanks(line, offset + 1);
+                        }
+                        else if (offset == line.size() || line[offset] != ']')
+                        {
+                            return _fail(line.data(), "expected , or ] in array");
+                        }
+                    }
+                    ++offset;
+                }
+                else
+                {
+                    if (!_iniItem(line, offset, "#;", item))
+                    {
+                        return false;
+                    }
+                    values.push_back(item);
+                }
+                offset = _skipBlanks(line, offset);
+                if (offset < line.size() && line[offset] != '#' && line[offset] != ';')
+                {
+                    return _fail(line.data(), "unexpected text after value");
+                }
+                return true;
+            }
+
+            /// @brief Parses quoted, literal or bare item of INI value
+            /// @param stops characters which end bare item
+            bool _iniItem(StringView line, size_t& offset, const char* stops, StringView& item)
+            {
+                if (offset < line.size() && line[offset] == '"')
+                {
+                    return _quoted(line, offset, item);
+                }
+                if (offset < line.size() && line[offset] == '\'')
+                {
+                    const void* closing = std::memchr(line.data() + offset + 1, '\'', line.size() - offset - 1);
+                    if (closing == nullptr)
+                    {
+                        return _fail(line.data(), "unterminated string");
+                    }
+                    const size_t closingOffset = static_cast<size_t>(static_cast<const char*>(closing) - line.data());
+                    item = StringView(line.data() + offset + 1, closingOffset - offset - 1);
+                    offset = closingOffset + 1;
+                    return true;
+                }
+                const size_t first = offset;
+                while (offset < line.size() && std::strchr(stops, line[offset]) == nullptr)
+                {
+                    ++offset;
+                }
+                item = _trim(StringView(line.data() + first, offset - first));
+                return true;
+            }
+
+            /// @brief Parses "quoted" string with JSON escapes. View into text is returned
+            /// if string has no escapes, otherwise string is unescaped into storage.
+            bool _quoted(StringView text, size_t& offset, StringView& item)
+            {
+                const size_t first = offset + 1;
+                size_t current = first;
+                bool escaped = false;
+                while (current < text.size() && text[current] != '"')
+                {
+                    if (text[current] == '\\')
+                    {
+                        escaped = true;
+                        ++current;
+                    }
+                    ++current;
+                }
+                if (current >= text.size())
+                {
+                    return _fail(text.data() + offset, "unterminated string");
+                }
+                offset = current + 1;
+                item = StringView(text.data() + first, current - first);
+                if (!escaped)
+                {
+                    return true;
+                }
+
+                std::string unescaped;
+                unescaped.reserve(item.size());
+                for (size_t i = 0; i < item.size(); ++i)
+                {
+                    if (item[i] != '\\')
+                    {
+                        unescaped.push_back(item[i]);
+                        continue;
+                    }
+                    ++i;
+                    switch (item[i])
+                    {
+                    case 'n': unescaped.push_back('\n'); break;
+                    case 't': unescaped.push_back('\t'); break;
+                    case 'r': unescaped.push_back('\r'); break;
+                    case 'b': unescaped.push_back('\b'); break;
+                    case 'f': unescaped.push_back('\f'); break;
+                    case 'u':
+                        if (!_unicodeEscape(item, i, unescaped))
+                        {
+                            return _fail(item.data() + i, "wrong \\u escape sequence");
+                        }
+                        break;
+                    default: unescaped.push_back(item[i]); break;
+                    }
+                }
+                m_strings.push_back(std::move(unescaped));
+                item = StringView(m_strings.back());
+                return true;
+            }
+
+            /// @brief Converts \uXXXX (and surrogate pair) to UTF-8
+            /// @param offset position of 'u', moved to last digit of sequence
+            static bool _unicodeEscape(StringView text, size_t& offset, std::string& out)
+            {
+                uint32_t code = 0;
+                if (!_hex4(text, offset + 1, code))
+                {
+                    return false;
+                }
+                offset += 4;
+                if (code >= 0xD800 && code <= 0xDBFF)
+                {
+                    uint32_t low = 0;
+                    if (offset + 2 >= text.size() || text[offset + 1] != '\\' || text[offset + 2] != 'u'
+                        || !_hex4(text, offset + 3, low) || low < 0xDC00 || low > 0xDFFF)
+                    {
+                        return false;
+                    }
+                    offset += 6;
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                if (code < 0x80)
+                {
+                    out.push_back(static_cast<char>(code));
+                }
+                else if (code < 0x800)
+                {
+                    out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                    out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                }
+                else if (code < 0x10000)
+                {
+                    out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                    out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                    out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                }
+                else
+                {
+                    out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+                    out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                    out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                    out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                }
+                return true;
+            }
+
+            static bool _hex4(StringView text, size_t offset, uint32_t& code)
+            {
+                if (offset + 4 > text.size())
+                {
+                    return false;
+                }
+                for (size_t i = offset; i < offset + 4; ++i)
+                {
+                    const char sym = text[i];
+                    code <<= 4;
+                    if (sym >= '0' && sym <= '9')
+                    {
+                        code |= static_cast<uint32_t>(sym - '0');
+                    }
+                    else if (sym >= 'a' && sym <= 'f')
+                    {
+                        code |= static_cast<uint32_t>(sym - 'a' + 10);
+                    }
+                    else if (sym >= 'A' && sym <= 'F')
+                    {
+                        code |= static_cast<uint32_t>(sym - 'A' + 10);
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            size_t _skipJsonSpaces(size_t offset) const noexcept
+            {
+                return _skipBlanks(m_text, offset);
+            }
+
+            /// @brief Parses object at offset. Keys of it are collected if section is empty,
+            /// otherwise only object under key equal to section is collected
+            bool _jsonObject(size_t& offset, StringView section)
+            {
+                offset = _skipJsonSpaces(offset + 1);
+                if (offset < m_text.size() && m_text[offset] == '}')
+                {
+                    ++offset;
+                    return true;
+                }
+                while (true)
+                {
+                    StringView key;
+                    if (offset == m_text.size() || m_text[offset] != '"')
+                    {
+                        return _fail(m_text.data() + offset, "expected key");
+                    }
+                    if (!_quoted(m_text, offset, key))
+                    {
+                        return false;
+                    }
+                    offset = _skipJsonSpaces(offset);
+                    if (offset == m_text.size() || m_text[offset] != ':')
+                    {
+                        return _fail(m_text.data() + offset, "expected :");
+                    }
+                    offset = _skipJsonSpaces(offset + 1);
+
+                    bool parsed = false;
+                    if (section.empty())
+                    {
+                        const size_t position = m_names.Find(key);
+                        if (position != PerfectHashIndex::kNotFound)
+                        {
+                            std::vector<StringView>& values = m_values[position];
+                            values.clear();
+                            if (!_jsonValue(offset, values))
+                            {
+                                return false;
+                            }
+                            parsed = true;
+                        }
+                    }
+                    else if (key == section && offset < m_text.size() && m_text[offset] == '{')
+                    {
+                        if (!_jsonObject(offset, StringView()))
+                        {
+                            return false;
+                        }
+                        parsed = true;
+                    }
+                    if (!parsed && !_skipJsonValue(offset))
+                    {
+                        return false;
+                    }
+
+                    offset = _skipJsonSpaces(offset);
+                    if (offset < m_text.size() && m_text[offset] == ',')
+                    {
+                        offset = _skipJsonSpaces(offset + 1);
+                        continue;
+                    }
+                    if (offset < m_text.size() && m_text[offset] == '}')
+                    {
+                        ++offset;
+                        return true;
+                    }
+                    return _fail(m_text.data() + offset, "expected , or }");
+                }
+            }
+
+            /// @brief Parses value of argument: scalar or array of scalars
+            bool _jsonValue(size_t& offset, std::vector<StringView>& values)
+            {
+                if (offset < m_text.size() && m_text[offset] == '[')
+                {
+                    offset = _skipJsonSpaces(offset + 1);
+                    if (offset < m_text.size() && m_text[offset] == ']')
+                    {
+                        ++offset;
+                        return true;
+                    }
+                    while (true)
+                    {
+                        if (!_jsonScalar(offset, values))
+                        {
+                            return false;
+                        }
+                        offset = _skipJsonSpaces(offset);
+                        if (offset < m_text.size() && m_text[offset] == ',')
+                        {
+                            offset = _skipJsonSpaces(offset + 1);
+                            continue;
+                        }
+                        if (offset < m_text.size() && m_text[offset] == ']')
+                        {
+                            ++offset;
+                            return true;
+                        }
+                        return _fail(m_text.data() + offset, "expected , or ]");
+                    }
+                }
+                return _jsonScalar(offset, values);
+            }
+
+            /// @brief Parses string, number, true, false or null. Null adds no value.
+            bool _jsonScalar(size_t& offset, std::vector<StringView>& values)
+            {
+                if (offset == m_text.size())
+                {
+                    return _fail(m_text.data() + offset, "expected value");
+                }
+                StringView item;
+                if (m_text[offset] == '"')
+                {
+                    if (!_quoted(m_text, offset, item))
+                    {
+                        return false;
+                    }
+                    values.push_back(item);
+                    return true;
+                }
+                if (m_text[offset] == '{' || m_text[offset] == '[')
+                {
+                    return _fail(m_text.data() + offset, "nested objects and arrays are not supported as argument value");
+                }
+                const size_t first = offset;
+                while (offset < m_text.size() && !isSpace(m_text[offset]) && m_text[offset] != ',' && m_text[offset] != '}' && m_text[offset] != ']')
+                {
+                    ++offset;
+                }
+                item = StringView(m_text.data() + first, offset - first);
+                if (item.empty())
+                {
+                    return _fail(m_text.data() + offset, "expected value");
+                }
+                if (!(item == "null"))
+                {
+                    values.push_back(item);
+                }
+                return true;
+            }
+
+            /// @brief Skips any JSON value without collecting it
+            bool _skipJsonValue(size_t& offset)
+            {
+                size_t depth = 0;
+                do
+                {
+                    if (offset == m_text.size())
+                    {
+                        return _fail(m_text.data() + offset, "unexpected end of file");
+                    }
+                    const char sym = m_text[offset];
+                    if (sym == '"')
+                    {
+                        ++offset;
+                        while (offset < m_text.size() && m_text[offset] != '"')
+                        {
+                            offset += m_text[offset] == '\\' ? 2 : 1;
+                        }
+                        if (offset >= m_text.size())
+                        {
+                            return _fail(m_text.data() + m_text.size(), "unterminated string");
+                        }
+                        ++offset;
+                    }
+                    else if (sym == '{' || sym == '[')
+                    {
+                        ++depth;
+                        ++offset;
+                    }
+                    else if (sym == '}' || sym == ']')
+                    {
+                        if (depth == 0)
+                        {
+                            return _fail(m_text.data() + offset, "expected value");
+                        }
+                        --depth;
+                        ++offset;
+                    }
+                    else if (depth == 0)
+                    {
+                        const size_t first = offset;
+                        while (offset < m_text.size() && !isSpace(m_text[offset]) && m_text[offset] != ',' && m_text[offset] != '}' && m_text[offset] != ']')
+                        {
+                            ++offset;
+                        }
+                        if (offset == first)
+                        {
+                            return _fail(m_text.data() + offset, "expected value");
+                        }
+                    }
+                    else
+                    {
+                        ++offset;
+                    }
+                } while (depth != 0);
+                return true;
+            }
+
+            const PerfectHashIndex& m_names;
+            std::vector<std::vector<StringView>>& m_values;
+            std::deque<std::string>& m_strings;
+            /// @brief text of current file, for line numbers in errors
+            StringView  m_text;
+            std::string m_error;
+        };
+    }
+
+    /// @brief anonymous namespace for internal usage
+    namespace 
+    {
+        const size_t kSizeTypeEnd = static_cast<size_t>(-1);
+        const size_t kHelpWidth = 80;
+        const size_t kHelpNameWidthPercent = 30;
+        const size_t kBatchChunkSize = 64;
+
+        bool isNumber(StringView inStr)
+        {
+            if (inStr.empty())
+            {
+                return false;
+            }
+            const bool hasNegSign = inStr[0] == '-';
+            size_t dotPos = 0, expPos = 0;
+            size_t startPos = static_cast<size_t>(hasNegSign);
+            for (size_t curPos = startPos; curPos < inStr.size(); ++curPos)
+            {
+                const char curChar = inStr[curPos];
+                if (curChar >= '0' && curChar <= '9')
+                {
+                    continue;
+                }
+                else if (curChar == '.'
+                    && !dotPos && curPos != startPos && curPos != inStr.size() - 1)
+                {
+                    dotPos = curPos;
+                }
+                else if ((curChar == 'e' || curChar == 'E')
+                    && !expPos && curPos != startPos && curPos != inStr.size() - 1)
+                {
+                    expPos = curPos;
+                    if (!dotPos)
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        size_t getStringStreamLength(std::stringstream& showDesc)
+        {
+            showDesc.seekp(0, std::ios::end);
+            return showDesc.tellp();
+        }
+    }
+
+
+    /// @brief Supported types for argument
+    /// If needed type is not in this list, then just use e_String
+    enum class ArgTypeCast : int
+    {
+        e_String,
+        e_int,
+        e_longlong,
+        e_double,
+        e_bool
+    };
+
+    /// @brief Formats of configuration files, see ArgumentParser::AddConfigFile
+    enum class ConfigFormat : int
+    {
+        /// @brief INI file or TOML subset: [section], key = value, # and ; comments
+        e_Ini,
+        /// @brief JSON object, key is long name of argument
+        e_Json
+    };
+
+#ifdef ARGPARSE_USE_PMR
+    /// @brief Container of parsed values, allocates from memory resource passed to ParseArgs
+    template<typename T>
+    using ValueVector = std::pmr::vector<T>;
+    /// @brief String of parsed values, allocates from memory resource passed to ParseArgs
+    using ValueString = std::pmr::string;
+#else
+    /// @brief Container of parsed values. Becomes std::pmr::vector if ARGPARSE_USE_PMR defined
+    template<typename T>
+    using ValueVector = std::vector<T>;
+    /// @brief String of parsed values. Becomes std::pmr::string if ARGPARSE_USE_PMR defined
+    using ValueString = std::string;
+#endif // ARGPARSE_USE_PMR
+
+    /// @brief Compile time mapping of C++ type to ArgTypeCast.
+    /// Defined only for supported types: bool, int, long long, double and std::string
+    template<typename T>
+    struct ArgTypeOf
+    {
+        static const bool kSupported = false;
+    };
+
+    template<>
+    struct ArgTypeOf<bool>
+    {
+        using StoredType = bool;
+        static const bool kSupported = true;
+        static const ArgTypeCast kValue = ArgTypeCast::e_bool;
+    };
+
+    template<>
+    struct ArgTypeOf<int>
+    {
+        using StoredType = int;
+        static const bool kSupported = true;
+        static const ArgTypeCast kValue = ArgTypeCast::e_int;
+    };
+
+    template<>
+    struct ArgTypeOf<long long>
+    {
+        using StoredType = long long;
+        static const bool kSupported = true;
+        static const ArgTypeCast kValue = ArgTypeCast::e_longlong;
+    };
+
+    template<>
+    struct ArgTypeOf<double>
+    {
+        using StoredType = double;
+        static const bool kSupported = true;
+        static const ArgTypeCast kValue = ArgTypeCast::e_double;
+    };
+
+    template<>
+    struct ArgTypeOf<std::string>
+    {
+        using StoredType = ValueString;
+        static const bool kSupported = true;
+        static const ArgTypeCast kValue = ArgTypeCast::e_String;
+    };
+
+    /// @brief Container type of parsed values of argument with type T
+    template<typename T>
+    using ValuesOf = ValueVector<typename ArgTypeOf<T>::StoredType>;
+
+#ifdef ARGPARSE_ENABLE_STATS
+    /// @brief Timings in nanoseconds and counters of one parse, see ArgumentsObject::GetStats.
+    /// Exists only if ARGPARSE_ENABLE_STATS is defined.
+    /// Phases scanNs, positionalNs, fallbackNs and validationNs don't overlap and are parts of totalNs.
+    /// Other timings are nested into phases and must not be summed with them:
+    /// conversionNs is spent inside scan, positional and fallback phases, choiceNs is part
+    /// of conversionNs, defaultsNs is part of validationNs.
+    struct ParseStats
+    {
+        /// @brief time of last Freeze of parser: names table, help and short names, config files.
+        /// Not part of totalNs, it is the same for all parses until parser is changed.
+        uint64_t buildNs = 0;
+        /// @brief phase: walk over input tokens, includes conversions of named arguments
+        /// and parsing of subcommand (it has own stats in subcommand result)
+        uint64_t scanNs = 0;
+        /// @brief phase: distribution of positional tokens, includes their conversions
+        uint64_t positionalNs = 0;
+        /// @brief phase: values taken from environment and config files, includes their conversions
+        uint64_t fallbackNs = 0;
+        /// @brief nested: conversions of tokens to values in all phases, includes choiceNs.
+        /// Lazy values are converted by getters and are not counted.
+        uint64_t conversionNs = 0;
+        /// @brief nested: checks of values against choices, part of conversionNs
+        uint64_t choiceNs = 0;
+        /// @brief nested: filling of absent arguments with default values, part of validationNs
+        uint64_t defaultsNs = 0;
+        /// @brief phase: final check of counts and required arguments, includes defaultsNs
+        uint64_t validationNs = 0;
+        /// @brief whole parse
+        uint64_t totalNs = 0;
+
+        /// @brief input tokens walked by scan, after expansion of response files
+        size_t tokens = 0;
+        /// @brief tokens left for positional arguments after scan
+        size_t positionalTokens = 0;
+        /// @brief tokens converted to values, counted with conversionNs
+        size_t conversions = 0;
+        /// @brief values checked against choices, counted with choiceNs
+        size_t choiceChecks = 0;
+        /// @brief arguments filled with default values, counted with defaultsNs
+        size_t defaults = 0;
+        /// @brief allocations of current thread while parsing, counted only if
+        /// ARGPARSE_STATS_IMPLEMENTATION is defined or RecordAllocation is called by your operator new
+        size_t allocations = 0;
+        /// @brief bytes requested by allocations, counted same way as allocations
+        size_t allocatedBytes = 0;
+    };
+
+    namespace detail
+    {
+        /// @brief allocations of one thread
+        struct AllocationCounters
+        {
+            size_t count = 0;
+            size_t bytes = 0;
+        };
+
+        inline AllocationCounters& allocationCounters() noexcept
+        {
+            static thread_local AllocationCounters counters;
+            return counters;
+        }
+
+        inline uint64_t nowNs() noexcept
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        /// @brief Adds time of its scope to given counter
+        class StatsTimer
+        {
+        public:
+            explicit StatsTimer(uint64_t& target) noexcept
+                : m_target(target)
+                , m_start(nowNs())
+            {}
+
+            StatsTimer(const StatsTimer&) = delete;
+            StatsTimer& operator=(const StatsTimer&) = delete;
+
+            ~StatsTimer()
+            {
+                m_target += nowNs() - m_start;
+            }
+
+        private:
+            uint64_t& m_target;
+            uint64_t  m_start;
+        };
+
+        /// @brief Resets stats and measures total time and allocations of one parse
+        class StatsScope
+        {
+        public:
+            StatsScope(ParseStats& stats, uint64_t buildNs) noexcept
+                : m_stats(stats)
+                , m_allocations(allocationCounters())
+            {
+                m_stats = ParseStats();
+                m_stats.buildNs = buildNs;
+                m_start = nowNs();
+            }
+
+            StatsScope(const StatsScope&) = delete;
+            StatsScope& operator=(const StatsScope&) = delete;
+
+            ~StatsScope()
+            {
+                m_stats.totalNs = nowNs() - m_start;
+                const AllocationCounters& counters = allocationCounters();
+                m_stats.allocations = counters.count - m_allocations.count;
+                m_stats.allocatedBytes = counters.bytes - m_allocations.bytes;
+            }
+
+        private:
+            ParseStats&        m_stats;
+            AllocationCounters m_allocations;
+            uint64_t           m_start = 0;
+        };
+    }
+
+    /// @brief Adds allocation to counters of current thread.
+    /// Call it from your replacement of operator new, if ARGPARSE_STATS_IMPLEMENTATION is not used.
+    /// @param bytes size of allocation
+    inline void RecordAllocation(size_t bytes) noexcept
+    {
+        detail::AllocationCounters& counters = detail::allocationCounters();
+        ++counters.count;
+        counters.bytes += bytes;
+    }
+#endif // ARGPARSE_ENABLE_STATS
+
+    namespace detail
+    {
+#ifdef ARGPARSE_USE_PMR
+        using MemoryResource = std::pmr::memory_resource;
+
+        inline MemoryResource* defaultResource() noexcept
+        {
+            return std::pmr::get_default_resource();
+        }
+#else
+        /// @brief Placeholder of memory resource, all storage uses std::allocator
+        struct MemoryResource
+        {};
+
+        inline MemoryResource* defaultResource() noexcept
+        {
+            return nullptr;
+        }
+#endif // ARGPARSE_USE_PMR
+
+        /// @brief Creates allocator of container which takes memory from given resource
+        template<typename Container>
+        typename Container::allocator_type makeAllocator(MemoryResource* resource) noexcept
+        {
+#ifdef ARGPARSE_USE_PMR
+            return typename Container::allocator_type(resource);
+#else
+            (void)resource;
+            return typename Container::allocator_type();
+#endif
+        }
+
+        /// @brief Tagged storage of values of one ArgTypeCast type.
+        /// Holds only vector of active type instead of one vector per supported type.
+        class TypedValues
+        {
+        public:
+            explicit TypedValues(ArgTypeCast type = ArgTypeCast::e_String, MemoryResource* resource = defaultResource())
+                : m_type(type)
+#ifdef ARGPARSE_USE_PMR
+                , m_resource(resource)
+#endif
+            {
+                (void)resource;
+                _construct();
+            }
+
+            /// @brief Copy takes memory from default resource, as std::pmr containers do
+            TypedValues(const TypedValues& other)
+                : m_type(other.m_type)
+#ifdef ARGPARSE_USE_PMR
+                , m_resource(defaultResource())
+#endif
+            {
+                _constructFrom(other);
+            }
+
+            TypedValues(TypedValues&& other) noexcept
+                : m_type(other.m_type)
+#ifdef ARGPARSE_USE_PMR
+                , m_resource(other.m_resource)
+#endif
+            {
+                _constructFrom(std::move(other));
+            }
+
+            /// @brief Assignment keeps memory resource of this storage.
+            /// Reuses capacity if both storages hold same type.
+            TypedValues& operator=(const TypedValues& other)
+            {
+                if (this == &other)
+                {
+                    return *this;
+                }
+                if (m_type == other.m_type)
+                {
+                    _assignFrom(other);
+                    return *this;
+                }
+                _destroy();
+                m_type = other.m_type;
+                _constructFrom(other);
+                return *this;
+            }
+
+            /// @brief Move assignment keeps memory resource of this storage too, as std::pmr containers do:
+            /// values are moved if both storages use equal resources and copied otherwise
+            TypedValues& operator=(TypedValues&& other)
+#ifndef ARGPARSE_USE_PMR
+                noexcept
+#endif
+            {
+                if (this == &other)
+                {
+                    return *this;
+                }
+#ifdef ARGPARSE_USE_PMR
+                if (!m_resource->is_equal(*other.m_resource))
+                {
+                    return *this = static_cast<const TypedValues&>(other);
+                }
+#endif
+                _destroy();
+                m_type = other.m_type;
+                _constructFrom(std::move(other));
+                return *this;
+            }
+
+            ~TypedValues()
+            {
+                _destroy();
+            }
+
+            /// @brief type of stored values
+            ArgTypeCast GetType() const noexcept
+            {
+                return m_type;
+            }
+
+            /// @brief Drops values and switches storage to given type.
+            /// Keeps capacity if type is not changed.
+            void Reset(ArgTypeCast type)
+            {
+                if (type == m_type)
+                {
+                    Clear();
+                    return;
+                }
+                _destroy();
+                m_type = type;
+                _construct();
+            }
+
+            /// @brief Drops values, keeps capacity
+            void Clear() noexcept
+            {
+                switch (m_type)
+                {
+                case ArgTypeCast::e_bool:
+                    m_bool.clear();
+                    break;
+                case ArgTypeCast::e_int:
+                    m_int.clear();
+                    break;
+                case ArgTypeCast::e_longlong:
+                    m_longLong.clear();
+                    break;
+                case ArgTypeCast::e_double:
+                    m_double.clear();
+                    break;
+                case ArgTypeCast::e_String:
+                default:
+                    m_string.clear();
+                    break;
+                }
+            }
+
+            /// @brief count of stored values
+            size_t Size() const noexcept
+            {
+                switch (m_type)
+                {
+                case ArgTypeCast::e_bool:
+                    return m_bool.size();
+                case ArgTypeCast::e_int:
+                    return m_int.size();
+                case ArgTypeCast::e_longlong:
+                    return m_longLong.size();
+                case ArgTypeCast::e_double:
+                    return m_double.size();
+                case ArgTypeCast::e_String:
+                default:
+                    return m_string.size();
+                }
+            }
+
+            bool Empty() const noexcept
+            {
+                return Size() == 0;
+            }
+
+            /// @brief Values of type T
+            /// @return stored vector or empty vector if storage holds other type
+            template<typename T>
+            const ValuesOf<T>& Values() const
+            {
+                static const ValuesOf<T> empty;
+                if (m_type != ArgTypeOf<T>::kValue)
+                {
+                    return empty;
+                }
+                return _vector(static_cast<T*>(nullptr));
+            }
+
+            /// @brief Values of type T for modification.
+            /// Storage is switched to type T if it holds other type.
+            template<typename T>
+            ValuesOf<T>& Values()
+            {
+                if (m_type != ArgTypeOf<T>::kValue)
+                {
+                    Reset(ArgTypeOf<T>::kValue);
+                }
+                return _vector(static_cast<T*>(nullptr));
+            }
+
+        private:
+            template<typename Container>
+            typename Container::allocator_type _allocator() const noexcept
+            {
+#ifdef ARGPARSE_USE_PMR
+                return makeAllocator<Container>(m_resource);
+#else
+                return makeAllocator<Container>(nullptr);
+#endif
+            }
+
+            void _construct()
+            {
+                switch (m_type)
+                {
+                case ArgTypeCast::e_bool:
+                    new (&m_bool) ValueVector<bool>(_allocator<ValueVector<bool>>());
+                    break;
+                case ArgTypeCast::e_int:
+                    new (&m_int) ValueVector<int>(_allocator<ValueVector<int>>());
+                    break;
+                case ArgTypeCast::e_longlong:
+                    new (&m_longLong) ValueVector<long long>(_allocator<ValueVector<long long>>());
+                    break;
+                case ArgTypeCast::e_double:
+                    new (&m_double) ValueVector<double>(_allocator<ValueVector<double>>());
+                    break;
+                case ArgTypeCast::e_String:
+                default:
+                    new (&m_string) ValueVector<ValueString>(_allocator<ValueVector<ValueString>>());
+                    break;
+                }
+            }
+
+            void _constructFrom(const TypedValues& other)
+            {
+                switch (m_type)
+                {
+                case ArgTypeCast::e_bool:
+                    new (&m_bool) ValueVector<bool>(other.m_bool, _allocator<ValueVector<bool>>());
+                    break;
+                case ArgTypeCast::e_int:
+                    new (&m_int) ValueVector<int>(other.m_int, _allocator<ValueVector<int>>());
+                    break;
+                case ArgTypeCast::e_longlong:
+                    new (&m_longLong) ValueVector<long long>(other.m_longLong, _allocator<ValueVector<long long>>());
+                    break;
+                case ArgTypeCast::e_double:
+                    new (&m_double) ValueVector<double>(other.m_double, _allocator<ValueVector<double>>());
+                    break;
+                case ArgTypeCast::e_String:
+                default:
+                    new (&m_string) ValueVector<ValueString>(other.m_string, _allocator<ValueVector<ValueString>>());
+                    break;
+                }
+            }
+
+            void _assignFrom(const TypedValues& other)
+            {
+                switch (m_type)
+                {
+                case ArgTypeCast::e_bool:
+                    m_bool = other.m_bool;
+                    break;
+                case ArgTypeCast::e_int:
+                    m_int = other.m_int;
+                    break;
+                case ArgTypeCast::e_longlong:
+                    m_longLong = other.m_longLong;
+                    break;
+                case ArgTypeCast::e_double:
+                    m_double = other.m_double;
+                    break;
+                case ArgTypeCast::e_String:
+                default:
+                    m_string = other.m_string;
+                    break;
+                }
+            }
+
+            void _constructFrom(TypedValues&& other) noexcept
+            {
+                switch (m_type)
+                {
+                case ArgTypeCast::e_bool:
+                    new (&m_bool) ValueVector<bool>(std::move(other.m_bool));
+                    break;
+                case ArgTypeCast::e_int:
+                    new (&m_int) ValueVector<int>(std::move(other.m_int));
+                    break;
+                case ArgTypeCast::e_longlong:
+                    new (&m_longLong) ValueVector<long long>(std::move(other.m_longLong));
+                    break;
+                case ArgTypeCast::e_double:
+                    new (&m_double) ValueVector<double>(std::move(other.m_double));
+                    break;
+                case ArgTypeCast::e_String:
+                default:
+                    new (&m_string) ValueVector<ValueString>(std::move(other.m_string));
+                    break;
+                }
+            }
+
+            void _destroy() noexcept
+            {
+                switch (m_type)
+                {
+                case ArgTypeCast::e_bool:
+                    m_bool.~vector();
+                    break;
+                case ArgTypeCast::e_int:
+                    m_int.~vector();
+                    break;
+                case ArgTypeCast::e_longlong:
+                    m_longLong.~vector();
+                    break;
+                case ArgTypeCast::e_double:
+                    m_double.~vector();
+                    break;
+                case ArgTypeCast::e_String:
+                default:
+                    m_string.~vector();
+                    break;
+                }
+            }
+
+            ValuesOf<bool>& _vector(bool*) { return m_bool; }
+            ValuesOf<int>& _vector(int*) { return m_int; }
+            ValuesOf<long long>& _vector(long long*) { return m_longLong; }
+            ValuesOf<double>& _vector(double*) { return m_double; }
+            ValuesOf<std::string>& _vector(std::string*) { return m_string; }
+            const ValuesOf<bool>& _vector(bool*) const { return m_bool; }
+            const ValuesOf<int>& _vector(int*) const { return m_int; }
+            const ValuesOf<long long>& _vector(long long*) const { return m_longLong; }
+            const ValuesOf<double>& _vector(double*) const { return m_double; }
+            const ValuesOf<std::string>& _vector(std::string*) const { return m_string; }
+
+            ArgTypeCast m_type;
+#ifdef ARGPARSE_USE_PMR
+            MemoryResource* m_resource;
+#endif
+            union
+            {
+                ValueVector<bool>        m_bool;
+                ValueVector<int>         m_int;
+                ValueVector<long long>   m_longLong;
+                ValueVector<double>      m_double;
+                ValueVector<ValueString> m_string;
+            };
+        };
+    }
+
+    /// @brief constant to indicate arguments with various
+    /// count from 0 to infinite
+    const int kAnyArgCount = -1;
+    /// @brief constant to indicate arguments with various
+    /// count from 1 to infinite
+    const int kFromOneToInfinteArgCount = -2;
+
+
+    class ArgumentParser;
+    class ArgumentsObject;
+    class ArgumentParsed;
+
+    /// @brief Lightweight typed handle of argument returned by ArgumentParser::AddArgument<T>.
+    /// Allows to get result from ArgumentsObject by index, without any name lookup.
+    /// @tparam T type of argument values: bool, int, long long, double or std::string
+    template<typename T>
+    class ArgHandle
+    {
+        static_assert(ArgTypeOf<T>::kSupported, "Supported types are bool, int, long long, double and std::string");
+    public:
+        /// @brief Creates handle which doesn't point to any argument
+        ArgHandle() noexcept
+            : m_position(static_cast<size_t>(-1))
+        {}
+
+        /// @brief index of argument in parser
+        /// @return size_t index
+        size_t GetPosition() const noexcept
+        {
+            return m_position;
+        }
+
+    private:
+        explicit ArgHandle(const size_t position) noexcept
+            : m_position(position)
+        {}
+
+        size_t m_position;
+
+        friend ArgumentParser;
+    };
+
+    /// @brief This class represents argument configuration
+    /// which should be passed to ArgumentParser objects instance
+    class Argument
+    {
+        /// @brief Default constructor. Private!
+        /// @param positionalName represents name for positional argument.
+        /// @param shortName represents short name for named argument which should be passed with one prefix.
+        /// @param longName represents long name for named argument which should be passed with double prefix.
+        /// @param argsCount integer number. You can use "kAnyArgCount", "kFromOneToInfinteArgCount" for non strict count or any int constant.
+        /// @param argType type of argument. Defined via enum. Supported types are: int, long long, double and bool and string for all other cases.
+        /// @param required Is argument required. Will fail parsing, if required argument are not present.
+        /// @param help Your own custom help string start.
+        Argument(const std::string& positionalName = "",
+            const std::string& shortName = "",
+            const std::string& longName = "",
+            const int argsCount = 1,
+            ArgTypeCast argType = ArgTypeCast::e_String,
+            const bool required = true,
+            const std::string& help = "")
+            : m_required(required)
+            , m_nargs(argsCount)
+            , m_type(argType)
+            , m_positionalName(positionalName)
+            , m_shortName(shortName)
+            , m_longName(longName)
+            , m_help(help)
+        {}
+    public:
+
+        /// @brief Default constructor positional arguments. You can use class Setters or pass your own values to public members directly.
+        /// @param shortName represents short name for named argument which should be passed with one prefix.
+        /// @param longName represents long name for named argument which should be passed with double prefix.
+        /// @param argsCount integer number. You can use "kAnyArgCount", "kFromOneToInfinteArgCount" for non strict count or any int constant.
+        /// @param argType type of argument. Defined via enum. Supported types are: int, long long, double and bool and string for all other cases.
+        /// @param required Is argument required. Will fail parsing, if required argument are not present.
+        /// @param help Your own custom help string start.
+        static Argument CreateNamedArgument(const std::string& shortName = "",
+            const std::string& longName = "",
+            const int argsCount = 1,
+            ArgTypeCast argType = ArgTypeCast::e_String,
+            const bool required = true,
+            const std::string& help = "")
+        {
+            return Argument("", shortName, longName, argsCount, argType, required, help);
+        }
+
+        /// @brief Default function for named arguments. You can use class Setters or pass your own values to public members directly.
+        /// @param positionalName represents name for positional argument.
+        /// @param argsCount integer number. You can use "kAnyArgCount", "kFromOneToInfinteArgCount" for non strict count or any int constant.
+        /// @param argType type of argument. Defined via enum. Supported types are: int, long long, double and bool and string for all other cases.
+        /// @param required Is argument required. Will fail parsing, if required argument are not present.
+        /// @param help Your own custom help string start.
+        static Argument CreatePositionalArgument(const std::string& positionalName = "",
+            const int argsCount = 1,
+            ArgTypeCast argType = ArgTypeCast::e_String,
+            const bool required = true,
+            const std::string& help = "")
+        {
+            return Argument(positionalName, "", "", argsCount, argType, required, help);
+        }
+
+        /// @brief required flag argument
+        /// If required argument is not set in command line
+        /// then parsing will fail.
+        /// All Arguments are required by default
+        bool m_required = true;
+
+        /// @brief Setter function to flag,
+        /// @param required - bool value to indicate is argument required or not
+        /// @return reference to current argument
+        Argument& SetRequired(bool required)
+        {
+            m_required = required;
+            return *this;
+        }
+
+        /// @brief variable that indicates count of argument in input
+        /// use "kAnyArgCount" or "kFromOneToInfinteArgCount" constants
+        /// for arguments with variable count. Any other arguments count
+        /// will be passed as strict arguments count.
+        /// 0 is for flags (arguments that doesn't carry any data)
+        /// set to 1 by default.
+        int m_nargs = 1;
+
+        /// @brief setter function for m_nargs with desired amount
+        /// @param amount int value that indicates  amount of argument.
+        /// Could be "kAnyArgCount" or "kFromOneToInfinteArgCount", 0 or any other positive integer.
+        /// @return reference to current argument
+        Argument& SetNumberOfArguments(int amount)
+        {
+            m_nargs = amount;
+            return *this;
+        }
+
+        /// @brief Handy setter for argument count with self declared name
+        /// @return reference to current argument
+        Argument& SetAnyNumberOfArgumentsButAtleastOne()
+        {
+            m_nargs = kFromOneToInfinteArgCount;
+            return *this;
+        }
+
+        /// @brief Handy setter for argument count with self declared name
+        /// @return reference to current argument
+        Argument& SetAnyNumberOfArguments()
+        {
+            m_nargs = kAnyArgCount;
+            return *this;
+        }
+
+        /// @brief Handy setter for argument which is actually a flag (e.g. has no any parameters)
+        /// @return reference to current argument
+        Argument& SetArgumentIsFlag()
+        {
+            m_nargs = 0;
+            return *this;
+        }
+
+        /// @brief Variable that hold type of argument.
+        /// string by default
+        ArgTypeCast m_type = ArgTypeCast::e_String;
+
+        /// @brief Setter function for type of current argument
+        /// @param argType setter for type of current argument data.
+        /// Any non string types will be casted while parsing.
+        /// @return reference to current argument
+        Argument& SetType(ArgTypeCast argType)
+        {
+            m_type = argType;
+            return *this;
+        }
+
+        /// @brief name of positional argument
+        /// positional arguments name used only to access desired argument from code
+        std::string m_positionalName = "";
+
+        /// @brief Handy setter for positional argument
+        /// @param name name for positional argument. Empty by default
+        /// @return reference to current argument
+        Argument& SetPositionalName(const std::string& name)
+        {
+            m_positionalName = name;
+            return *this;
+        }
+
+        /// @brief arguments short name
+        /// for non positional argument only
+        /// shot name used in input with 1 prefix
+        std::string m_shortName = "";
+
+        /// @brief Handy setter for short named argument. 
+        /// Should been used with ordinary prefix in command line.
+        /// Can be auto-generated if possible when m_allowAbbrev in ArgymentParsed set to true.
+        /// @param name name for positional argument. Empty by default
+        /// @return reference to current argument
+        Argument& SetShortName(const std::string& name)
+        {
+            m_shortName = name;
+            return *this;
+        }
+        
+        /// @brief arguments long name.
+        /// for non positional arguments only
+        /// argument long name start with double prefix
+        std::string m_longName = "";
+
+        /// @brief Handy setter for long named argument. 
+        /// Should been used with double prefix in command line.
+        /// Can be used for auto-generation of short name if it possible
+        /// and m_allowAbbrev in ArgymentParsed is "true".
+        /// @param name name for positional argument. Empty by default
+        /// @return reference to current argument
+        Argument& SetLongName(const std::string& name)
+        {
+            m_longName = name;
+            return *this;
+        }
+
+        /// @brief additional help info for argument
         /// Will be part of generated help
         std::string m_help = "";
 
-        /// @brief Handy setter for additional help
-        /// @param help string with additional help. Empty by default.
-        /// @return reference to current argument
-        Argument& SetHelp(const std::string& help)
+        /// @brief Handy setter for additional help
+        /// @param help string with additional help. Empty by default.
+        /// @return reference to current argument
+        Argument& SetHelp(const std::string& help)
+        {
+            m_help = help;
+            return *this;
+        }
+
+        /// @brief name of environment variable which gives value
+        /// if argument is not present in command line
+        std::string m_env = "";
+
+        /// @brief Setter of environment variable for argument. Value of variable is parsed
+        /// as one token, for arguments with several values it is split by shell rules.
+        /// Flags accept true or false. Command line wins over environment,
+        /// environment wins over config files and default values.
+        /// @param name name of environment variable. Empty by default.
+        /// @return reference to current argument
+        Argument& SetEnv(const std::string& name)
+        {
+            m_env = name;
+            return *this;
+        }
+        
+        /// @brief vector of strings to validate arguments input data.
+        /// Empty by default. Will fail parsing if string not is in input list
+        std::vector<std::string> m_choicesString = {};
+
+        /// @brief Handy setter of valid choices for arguments with string type
+        /// @param choices vector or initializer list of valid strings
+        /// @return reference to current argument
+        Argument& SetChoices(const std::vector<std::string>& choices)
+        {
+            if (m_type != ArgTypeCast::e_String)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_choicesString = choices;
+            return *this;
+        }
+
+        /// @brief vector of integers to validate arguments input data.
+        /// Empty by default. Will fail parsing if ints not is in input list
+        std::vector<int> m_choicesInt = {};
+
+        /// @brief Handy setter of valid choices for arguments with int type
+        /// @param choices vector or initializer list of valid ints
+        /// @return reference to current argument
+        Argument& SetChoices(const std::vector<int>& choices)
+        {
+            if (m_type != ArgTypeCast::e_int)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_choicesInt = choices;
+            return *this;
+        }
+
+        /// @brief vector of long longs to validate arguments input data.
+        /// Empty by default. Will fail parsing if long longs not is in input list
+        std::vector<long long> m_choicesLongLong = {};
+
+        /// @brief Handy setter of valid choices for arguments with long long type
+        /// @param choices vector or initializer list of valid long longs
+        /// @return reference to current argument
+        Argument& SetChoices(const std::vector<long long>& choices)
+        {
+            if (m_type != ArgTypeCast::e_longlong)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_choicesLongLong = choices;
+            return *this;
+        }
+
+        /// @brief vector of double to validate arguments input data.
+        /// Empty by default. Will fail parsing if double not is in input list
+        std::vector<double> m_choicesDouble = {};
+
+        /// @brief Handy setter of valid choices for arguments with double type
+        /// @param choices vector or initializer list of valid double
+        /// @return reference to current argument
+        Argument& SetChoices(const std::vector<double>& choices)
+        {
+            if (m_type != ArgTypeCast::e_double)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_choicesDouble = choices;
+            return *this;
+        }
+
+        /// @brief Handy setter for single default argument of bool type
+        /// @param defaultArg default boolean value
+        /// @return reference to current argument
+        Argument& SetDefault(bool defaultArg)
+        {
+            if (m_type != ArgTypeCast::e_bool)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_default.Values<bool>().push_back(defaultArg);
+            m_hasDefault = true;
+            return *this;
+        }
+
+        /// @brief Handy setter for single default argument of int type
+        /// @param defaultArg default int value
+        /// @return reference to current argument
+        Argument& SetDefault(int defaultArg)
+        {
+            if (m_type != ArgTypeCast::e_int)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_default.Values<int>().push_back(defaultArg);
+            m_hasDefault = true;
+            return *this;
+        }
+
+        /// @brief Handy setter for single default argument of long long type
+        /// @param defaultArg default long long value
+        /// @return reference to current argument
+        Argument& SetDefault(long long defaultArg)
+        {
+            if (m_type != ArgTypeCast::e_longlong)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_default.Values<long long>().push_back(defaultArg);
+            m_hasDefault = true;
+            return *this;
+        }
+
+        /// @brief Handy setter for single default argument of double type
+        /// @param defaultArg default double value
+        /// @return reference to current argument
+        Argument& SetDefault(double defaultArg)
+        {
+            if (m_type != ArgTypeCast::e_double)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_default.Values<double>().push_back(defaultArg);
+            m_hasDefault = true;
+            return *this;
+        }
+
+        /// @brief Handy setter for single default argument of string type
+        /// @param defaultArg default string value
+        /// @return reference to current argument
+        Argument& SetDefault(std::string defaultArg)
+        {
+            if (m_type != ArgTypeCast::e_String)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_default.Values<std::string>().emplace_back(defaultArg.data(), defaultArg.size());
+            m_hasDefault = true;
+            return *this;
+        }
+
+        /// @brief Handy setter for vector of default arguments of bool type
+        /// @param defaultArg vector of default boolean values
+        /// @return reference to current argument
+        Argument& SetDefault(const std::vector<bool>& defaultArg)
+        {
+            if (m_type != ArgTypeCast::e_bool)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_default.Values<bool>().assign(defaultArg.begin(), defaultArg.end());
+            m_hasDefault = true;
+            return *this;
+        }
+
+        /// @brief Handy setter for vector of default arguments of int type
+        /// @param defaultArg vector of default int values
+        /// @return reference to current argument
+        Argument& SetDefault(const std::vector<int>& defaultArg)
+        {
+            if (m_type != ArgTypeCast::e_int)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_default.Values<int>().assign(defaultArg.begin(), defaultArg.end());
+            m_hasDefault = true;
+            return *this;
+        }
+
+        /// @brief Handy setter for vector of default arguments of long long type
+        /// @param defaultArg vector of default long values
+        /// @return reference to current argument
+        Argument& SetDefault(const std::vector<long long>& defaultArg)
+        {
+            if (m_type != ArgTypeCast::e_longlong)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_default.Values<long long>().assign(defaultArg.begin(), defaultArg.end());
+            m_hasDefault = true;
+            return *this;
+        }
+
+        /// @brief Handy setter for vector of default arguments of double type
+        /// @param defaultArg vector of default double values
+        /// @return reference to current argument
+        Argument& SetDefault(const std::vector<double>& defaultArg)
+        {
+            if (m_type != ArgTypeCast::e_double)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_default.Values<double>().assign(defaultArg.begin(), defaultArg.end());
+            m_hasDefault = true;
+            return *this;
+        }
+
+        /// @brief Handy setter for vector of default arguments of string type
+        /// @param defaultArg vector of default string values
+        /// @return reference to current argument
+        Argument& SetDefault(const std::vector<std::string>& defaultArg)
+        {
+            if (m_type != ArgTypeCast::e_String)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_default.Values<std::string>().assign(defaultArg.begin(), defaultArg.end());
+            m_hasDefault = true;
+            return *this;
+        }
+
+
+        /// @brief Getter to indicate does argument has any default value
+        /// @return reference to current argument
+        bool HasDefault() const
+        {
+            return m_hasDefault;
+        }
+
+        /// @brief Getter to indicate does argument has any choices
+        /// @return bool value
+        bool HasChoices() const
+        {
+            return m_choicesDouble.size() + m_choicesInt.size() + m_choicesLongLong.size() + m_choicesString.size() != 0;
+        }
+
+        /// @brief Binds argument to external variable. Parsed or default value is written
+        /// to variable directly while parsing, result keeps only existence and count of values,
+        /// so single value getters of result throw for bound argument.
+        /// If argument takes many values, last one is stored. Flag bound to bool becomes true when met.
+        /// If argument is absent and has no default, variable is reset to value initialized one
+        /// (false for flag), so parser can be reused. Values are written as they are parsed,
+        /// so failed parse may leave variables partly updated.
+        /// Variable is written by every parse, so bound parser shouldn't parse from many threads at once.
+        /// @tparam T type of variable: bool, int, long long, double or std::string, should match argument type
+        /// @param target pointer to variable, must outlive parser
+        /// @return reference to current argument
+        template<typename T>
+        Argument& BindTo(T* target)
+        {
+            static_assert(ArgTypeOf<T>::kSupported, "only bool, int, long long, double and std::string are supported");
+            if (ArgTypeOf<T>::kValue != m_type)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_bound = target;
+            m_boundType = m_type;
+            m_boundToVector = false;
+            return *this;
+        }
+
+        /// @brief Binds argument to external vector, all parsed or default values are appended to it.
+        /// Vector is cleared when argument is met in input, default is applied or argument is absent.
+        /// @tparam T type of vector elements, should match argument type
+        /// @param target pointer to vector, must outlive parser
+        /// @return reference to current argument
+        template<typename T>
+        Argument& BindTo(std::vector<T>* target)
+        {
+            static_assert(ArgTypeOf<T>::kSupported, "only bool, int, long long, double and std::string are supported");
+            if (ArgTypeOf<T>::kValue != m_type)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_bound = target;
+            m_boundType = m_type;
+            m_boundToVector = true;
+            return *this;
+        }
+
+        /// @brief Getter to indicate does argument write values to external variable
+        /// @return bool value
+        bool IsBound() const
+        {
+            return m_bound != nullptr;
+        }
+
+        /// @brief Streams values of argument to callback instead of storing them in result.
+        /// Every value is passed to sink right after conversion and choices check, so
+        /// processing starts before parsing ends and memory doesn't grow with count of values.
+        /// Result keeps only existence and count of values. Default values are streamed too.
+        /// Only variadic positional argument with sink is parsed without buffering of positional tokens.
+        /// Sink is called from parsing thread, for ParseBatch it should be thread safe.
+        /// @tparam T type of value: bool, int, long long, double or StringView, should match argument type.
+        /// String arguments take StringView only, it points into input and is valid only during the call.
+        /// @param sink callback for values
+        /// @return reference to current argument
+        template<typename T>
+        Argument& SetSink(const std::function<void(T)>& sink)
+        {
+            // values of string arguments are passed as StringView, so std::string would be read from wrong object
+            static_assert(!std::is_same<T, std::string>::value, "sink of string argument takes StringView");
+            typedef typename std::conditional<std::is_same<T, StringView>::value, std::string, T>::type StoredType;
+            static_assert(ArgTypeOf<StoredType>::kSupported, "only bool, int, long long, double and StringView are supported");
+            if (ArgTypeOf<StoredType>::kValue != m_type)
+            {
+                throw std::runtime_error("wrong type");
+            }
+            m_sink = [sink](const void* value)
+            {
+                sink(*static_cast<const T*>(value));
+            };
+            m_sinkType = m_type;
+            return *this;
+        }
+
+        /// @brief Getter to indicate does argument stream values to sink
+        /// @return bool value
+        bool HasSink() const
+        {
+            return static_cast<bool>(m_sink);
+        }
+
+    private:
+        /// @brief Builds sorted copy of choices of argument type for binary search, called by Freeze
+        void _indexChoices()
+        {
+            m_choicesSorted = detail::TypedValues();
+            switch (m_type)
+            {
+            case ArgTypeCast::e_String:
+                _indexChoices(m_choicesString);
+                break;
+            case ArgTypeCast::e_int:
+                _indexChoices(m_choicesInt);
+                break;
+            case ArgTypeCast::e_longlong:
+                _indexChoices(m_choicesLongLong);
+                break;
+            case ArgTypeCast::e_double:
+                _indexChoices(m_choicesDouble);
+                break;
+            default:
+                break;
+            }
+        }
+
+        template<typename T>
+        void _indexChoices(const std::vector<T>& choices)
+        {
+            ValuesOf<T>& sorted = m_choicesSorted.Values<T>();
+            sorted.assign(choices.begin(), choices.end());
+            std::sort(sorted.begin(), sorted.end());
+            sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        }
+
+        /// @brief Checks if token is one of string choices, O(log n)
+        bool _inChoices(StringView token) const
+        {
+            const ValuesOf<std::string>& sorted = m_choicesSorted.Values<std::string>();
+            auto it = std::lower_bound(sorted.begin(), sorted.end(), token,
+                [](const ValueString& choice, StringView value) -> bool
+                {
+                    return StringView(choice) < value;
+                });
+            return it != sorted.end() && StringView(*it) == token;
+        }
+
+        /// @brief Checks if integer value is one of choices, O(log n)
+        template<typename T>
+        bool _inChoices(T value) const
+        {
+            const ValuesOf<T>& sorted = m_choicesSorted.Values<T>();
+            return std::binary_search(sorted.begin(), sorted.end(), value);
+        }
+
+        /// @brief Checks if double value equals to one of choices with epsilon precision, O(log n)
+        bool _inChoices(double value) const
+        {
+            const double epsilon = std::numeric_limits<double>::epsilon();
+            const ValuesOf<double>& sorted = m_choicesSorted.Values<double>();
+            auto it = std::lower_bound(sorted.begin(), sorted.end(), value - epsilon);
+            return it != sorted.end() && *it <= value + epsilon;
+        }
+
+        bool                m_hasDefault = false;
+        /// @brief default values, only vector of one type is stored
+        detail::TypedValues m_default;
+        /// @brief sorted unique copy of choices of argument type for lookup while parsing, built by Freeze
+        detail::TypedValues m_choicesSorted;
+        /// @brief external variable or std::vector set by BindTo, nullptr if not bound
+        void*               m_bound = nullptr;
+        /// @brief type of bound variable, checked against m_type when argument is added
+        ArgTypeCast         m_boundType = ArgTypeCast::e_String;
+        bool                m_boundToVector = false;
+        /// @brief callback set by SetSink, takes pointer to converted value
+        std::function<void(const void*)> m_sink;
+        /// @brief type of sink values, checked against m_type when argument is added
+        ArgTypeCast         m_sinkType = ArgTypeCast::e_String;
+        /// @brief values are converted on first access, set by ArgumentParser::SetLazyConversion
+        bool                m_lazy = false;
+        /// @brief copy of compiled argument for lazy conversion, built by Freeze.
+        /// Results share it, so their values can be read after parser is changed or destroyed.
+        std::shared_ptr<const Argument> m_lazyCopy;
+
+        friend ArgumentsObject;
+        friend ArgumentParser;
+        friend ArgumentParsed;
+    };
+
+    /// @brief Helper function to create named argument
+    /// @param shortName Short name if needed. Will be used with single prefix.
+    /// Short name could be auto-generated if possible when m_allowAbbrev in ArgymentParsed set to true)
+    /// @param longName Full name of argument
+    /// @param argsCount Count of arguments
+    /// (use kFromOneToInfinteArgCount or kAnyArgCount for various arguments count)
+    /// @param argType e_String, e_int, e_longlong, e_double, e_bool
+    /// @param required Marker if argument should be passed or ignored if missed.
+    /// @param help Initial part of help for current argument in case of auto-generated help.
+    /// @return instance of Argument
+    Argument CreateNamedArgument(const std::string& shortName = "",
+        const std::string& longName = "",
+        const int argsCount = 1,
+        ArgTypeCast argType = ArgTypeCast::e_String,
+        const bool required = true,
+        const std::string& help = "")
+    {
+        return Argument::CreateNamedArgument(shortName, longName, argsCount, argType, required, help);
+    }
+
+    /// @brief Helper function to create positional argument
+    /// @param positionalName Name of positional argument to access from code.
+    /// @param argsCount Count of arguments
+    /// (use kFromOneToInfinteArgCount or kAnyArgCount for various arguments count)
+    /// @param argType e_String, e_int, e_longlong, e_double, e_bool
+    /// @param required Marker if argument should be passed or ignored if missed.
+    /// @param help Initial part of help for current argument in case of auto-generated help.
+    /// @return instance of Argument
+    Argument CreatePositionalArgument(const std::string& positionalName = "",
+        const int argsCount = 1,
+        ArgTypeCast argType = ArgTypeCast::e_String,
+        const bool required = true,
+        const std::string& help = "")
+    {
+        return Argument::CreatePositionalArgument(positionalName, argsCount, argType, required, help);
+    }
+
+    /// @brief Class which represent actual parsed argument in case of successfully parsing
+    class ArgumentParsed
+    {
+    public:
+        /// @brief Does argument exists. Needed to check in case when argument is not required
+        /// @return bool value
+        bool GetArgumentExists() const
+        {
+            return m_exists;
+        }
+
+        /// @brief get actual count of argument, in case of various arguments count.
+        /// @return 
+        size_t GetArgumentCount() const
         {
-            m_help = help;
-            return *this;
+            return m_count;
+        }
+
+        /// @brief Get result as single bool for bool type arguments. Added for c++11 support.
+        /// Starting from c++17 you can use Get()
+        /// @return bool value of argument
+        const bool GetAsBool() const
+        {
+            return _front<bool>();
+        }
+
+        /// @brief Get result as single int for int type arguments. Added for c++11 support.
+        /// Starting from c++17 you can use Get()
+        /// @return int value of argument
+        const int GetAsInt() const
+        {
+            return _front<int>();
+        }
+
+        /// @brief Get result as single long long for long long type arguments. Added for c++11 support.
+        /// Starting from c++17 you can use Get()
+        /// @return long long value of argument
+        const long long GetAsLongLong() const
+        {
+            return _front<long long>();
+        }
+
+
+        /// @brief Get result as single double for double type arguments. Added for c++11 support.
+        /// Starting from c++17 you can use Get()
+        /// @return double value of argument
+        const double GetAsDouble() const
+        {
+            return _front<double>();
+        }
+
+
+        /// @brief Get result as single string for string type arguments. Added for c++11 support.
+        /// Starting from c++17 you can use Get()
+        /// @return string value of argument
+        const ValueString& GetAsString() const
+        {
+            return _front<std::string>();
+        }
+
+        /// @brief Get result as vector bool for bool type arguments. Added for c++11 support.
+        /// Starting from c++17 you can use Get()
+        /// @return vector bool value of argument
+        const ValuesOf<bool>& GetAsVecBool() const
+        {
+            return _values().Values<bool>();
+        }
+
+        /// @brief Get result as vector int for int type arguments. Added for c++11 support.
+        /// Starting from c++17 you can use Get()
+        /// @return vector int value of argument
+        const ValuesOf<int>& GetAsVecInt() const
+        {
+            return _values().Values<int>();
+        }
+
+        /// @brief Get result as vector long long for long long type arguments. Added for c++11 support.
+        /// Starting from c++17 you can use Get()
+        /// @return vector long long value of argument
+        const ValuesOf<long long>& GetAsVecLongLong() const
+        {
+            return _values().Values<long long>();
+        }
+
+        /// @brief Get result as vector double for double type arguments. Added for c++11 support.
+        /// Starting from c++17 you can use Get()
+        /// @return vector double value of argument
+        const ValuesOf<double>& GetAsVecDouble() const
+        {
+            return _values().Values<double>();
+        }
+
+        /// @brief Get result as vector string for string type arguments. Added for c++11 support.
+        /// Starting from c++17 you can use Get()
+        /// @return vector string value of argument
+        const ValuesOf<std::string>& GetAsVecString() const
+        {
+            return _values().Values<std::string>();
+        }
+
+        /// @brief Get result as vector of given type
+        /// @tparam T bool, int, long long, double or std::string
+        /// @return vector of values of argument
+        template<typename T>
+        const ValuesOf<T>& GetAsVec() const
+        {
+            return _values().Values<T>();
+        }
+
+#ifdef ARGPARSE_HAS_CXX17
+        /// @brief Function to get actual argument value
+        /// @return std::any: could be bool, int, long long, double, string 
+        /// and vector variants of same types regarding of arguments type.
+        std::any Get() const
+        {
+            switch (_values().GetType())
+            {
+            case argparse::ArgTypeCast::e_String:
+                if (m_count == 1)
+                {
+                    return _front<std::string>();
+                }
+                return _values().Values<std::string>();
+                break;
+            case argparse::ArgTypeCast::e_int:
+                if (m_count == 1)
+                {
+                    return _front<int>();
+                }
+                return _values().Values<int>();
+                break;
+            case argparse::ArgTypeCast::e_longlong:
+                if (m_count == 1)
+                {
+                    return _front<long long>();
+                }
+                return _values().Values<long long>();
+                break;
+            case argparse::ArgTypeCast::e_double:
+                if (m_count == 1)
+                {
+                    return _front<double>();
+                }
+                return _values().Values<double>();
+                break;
+            case argparse::ArgTypeCast::e_bool:
+            default:
+                if (m_count == 1)
+                {
+                    return _front<bool>();
+                }
+                return _values().Values<bool>();
+                break;
+            }
+        }
+
+#endif // ARGPARSE_HAS_CXX17
+
+
+    protected:
+
+        ArgumentParsed() {}
+
+        /// @brief Values for getters, converts values recorded in lazy mode first
+        const detail::TypedValues& _values() const
+        {
+            if (m_lazyPending.Load())
+            {
+                _convertLazy();
+            }
+            return m_values;
+        }
+
+        /// @brief First value for single value getters
+        /// @throw std::runtime_error if result keeps no values: argument is absent, is a flag,
+        /// or its values are written to variable set by Argument::BindTo or passed to sink
+        template<typename T>
+        typename ValuesOf<T>::const_reference _front() const
+        {
+            const ValuesOf<T>& values = _values().Values<T>();
+            if (values.empty())
+            {
+                throw std::runtime_error("Argument has no values in result, it is absent or its values are written to bound variable or sink");
+            }
+            return values.front();
+        }
+
+        /// @brief Converts recorded tokens to values and checks choices, result is cached.
+        /// Conversion runs under lock, so first access from several threads at once is safe.
+        /// @throw std::runtime_error if token cannot be converted or is out of choices
+        void _convertLazy() const
+        {
+            // conversion happens once per slot, so one lock for all slots doesn't contend
+            static std::mutex conversionMutex;
+            std::lock_guard<std::mutex> lock(conversionMutex);
+            if (!m_lazyPending.Load())
+            {
+                return;
+            }
+            const Argument& argObj = *m_lazyArgument;
+            size_t first = 0;
+            for (size_t i = 0; i < m_lazyEnds.size(); ++i)
+            {
+                const StringView token(m_lazyText.data() + first, m_lazyEnds[i] - first);
+                first = m_lazyEnds[i];
+                switch (m_values.GetType())
+                {
+                case ArgTypeCast::e_int:
+                    _convertToken<int>(argObj, token);
+                    break;
+                case ArgTypeCast::e_longlong:
+                    _convertToken<long long>(argObj, token);
+                    break;
+                case ArgTypeCast::e_double:
+                default:
+                    _convertToken<double>(argObj, token);
+                    break;
+                }
+            }
+            m_lazyPending.Store(false);
+        }
+
+        template<typename T>
+        void _convertToken(const Argument& argObj, StringView token) const
+        {
+            T value = 0;
+            if (!_convertNumber(token, value))
+            {
+                _lazyError(argObj, "cannot parse [\"" + std::string(token) + "\"] for  argument ");
+            }
+            if (argObj.HasChoices() && !argObj._inChoices(value))
+            {
+                _lazyError(argObj, "Value '" + std::string(token) + "' is out of choices for ");
+            }
+            m_values.Values<T>().push_back(value);
+        }
+
+        template<typename T>
+        static bool _convertNumber(StringView token, T& value)
+        {
+            return detail::parseInteger(token, value) == detail::ConversionResult::e_Ok;
+        }
+
+        static bool _convertNumber(StringView token, double& value)
+        {
+            return detail::parseDouble(token, value) == detail::ConversionResult::e_Ok;
+        }
+
+        /// @brief Drops values converted so far and throws, so next access tries again and throws same error
+        [[noreturn]] void _lazyError(const Argument& argObj, const std::string& message) const
+        {
+            const std::string& name = argObj.m_longName.empty() ? (argObj.m_shortName.empty() ? argObj.m_positionalName : argObj.m_shortName) : argObj.m_longName;
+            m_values.Clear();
+            throw std::runtime_error(message + "\"" + name + "\"");
+        }
+
+        /// @brief Creates empty result which stores values in given memory resource
+        explicit ArgumentParsed(detail::MemoryResource* resource)
+            : m_values(ArgTypeCast::e_String, resource)
+            , m_lazyText(detail::makeAllocator<ValueString>(resource))
+            , m_lazyEnds(detail::makeAllocator<ValueVector<size_t>>(resource))
+        {}
+
+        /// @brief flag about is argument exists
+        bool        m_exists{ false };
+        /// @brief count of arguments properties
+        size_t      m_count{ 0 };
+        /// @brief container of parsed values, holds vector of argument type only.
+        /// Mutable, because values of lazy arguments are converted by getters.
+        mutable detail::TypedValues m_values;
+        /// @brief values are recorded as tokens and not converted yet
+        mutable detail::CopyableAtomicFlag m_lazyPending;
+        /// @brief copy of argument recorded tokens belong to, see Argument::m_lazyCopy
+        std::shared_ptr<const Argument> m_lazyArgument;
+        /// @brief tokens of lazy argument written one after another
+        ValueString m_lazyText;
+        /// @brief end offsets of tokens in m_lazyText
+        ValueVector<size_t> m_lazyEnds;
+
+        friend ArgumentsObject;
+    };
+
+    /// @brief Cass that carries result of real parsing
+    /// Indicates if parsing is successful and allows to get ArgumentParsed object in that case.
+    /// In case of parsing failure provides error string for first error.
+    class ArgumentsObject
+    {
+    public:
+        /// @brief Indicates if parsing was successful
+        /// @return bool value
+        bool IsArgValid() const
+        {
+            return m_isValid;
+        }
+
+        /// @brief Function to get error message in case of parsing failure.
+        /// @return string with error message
+        const std::string& GetErrorString() const
+        {
+            return m_error;
+        }
+
+        /// @brief I don't know when you could need this info
+        /// @return size_t count of successfully parsed arguments
+        const size_t ParsedArgsCount() const
+        {
+            return m_parsedCount;
+        }
+
+        /// @brief Getter function to get ArgumentParsed object 
+        /// @param name name of argument object, could be short name, long name or positional name
+        /// @return Empty argument if argument with given name doesn't exists or real result if exists.
+        const ArgumentParsed& GetArg(const std::string& name) const
+        {
+            if (!m_names)
+            {
+                return m_missing;
+            }
+
+            const auto position = m_names->find(name);
+            if (position == m_names->end())
+            {
+                return m_missing;
+            }
+
+            return GetArgByPosition(position->second);
+        }
+
+        /// @brief Getter function to get ArgumentParsed object by handle, without name lookup
+        /// @param handle handle returned by ArgumentParser::AddArgument<T>
+        /// @return Empty argument if argument doesn't exists or real result if exists.
+        template<typename T>
+        const ArgumentParsed& GetArg(const ArgHandle<T>& handle) const
+        {
+            return GetArgByPosition(handle.GetPosition());
+        }
+
+        /// @brief Typed access to values of argument by handle, without name lookup
+        /// @param handle handle returned by ArgumentParser::AddArgument<T>
+        /// @return vector of values. Empty if argument doesn't exists
+        template<typename T>
+        const ValuesOf<T>& operator[](const ArgHandle<T>& handle) const
+        {
+            return GetArgByPosition(handle.GetPosition()).template GetAsVec<T>();
+        }
+
+        /// @brief Creates empty result to be filled by ArgumentParser::ParseInto
+        /// @param resource memory resource of values (std::pmr::memory_resource* if ARGPARSE_USE_PMR defined).
+        /// Must outlive this object.
+        explicit ArgumentsObject(detail::MemoryResource* resource = detail::defaultResource())
+            : m_resource(resource)
+            , m_parsed(detail::makeAllocator<ValueVector<ArgumentParsed>>(resource))
+            , m_stringPool(detail::makeAllocator<ValueVector<ValueString>>(resource))
+            , m_positionalTokens(detail::makeAllocator<ValueVector<StringView>>(resource))
+        {}
+
+        /// @brief Drops all parsed values and error.
+        /// Keeps memory of values and strings, so next ParseInto with similar input doesn't allocate.
+        void Reset()
+        {
+            for (auto& arg : m_parsed)
+            {
+                ReleaseSlot(arg);
+            }
+            m_positionalTokens.clear();
+            m_parsedCount = 0;
+            m_isValid = false;
+            m_error.clear();
+            m_subcommand.clear();
+        }
+
+        /// @brief Name of subcommand met in input, see ArgumentParser::AddSubparser
+        /// @return name of subcommand, empty if there was no subcommand
+        const std::string& GetSubcommand() const noexcept
+        {
+            return m_subcommand;
+        }
+
+        /// @brief Result of subcommand parser
+        /// @return arguments parsed by subcommand parser
+        /// @throw std::runtime_error if there was no subcommand
+        const ArgumentsObject& GetSubcommandArgs() const
+        {
+            if (m_subcommand.empty())
+            {
+                throw std::runtime_error("No subcommand was parsed");
+            }
+            return m_subcommandArgs.front();
+        }
+
+#ifdef ARGPARSE_ENABLE_STATS
+        /// @brief Timings and counters of parse which filled this object
+        /// @return stats, exists only if ARGPARSE_ENABLE_STATS is defined
+        const ParseStats& GetStats() const noexcept
+        {
+            return m_stats;
+        }
+#endif
+
+    private:
+        const ArgumentParsed& GetArgByPosition(const size_t position) const
+        {
+            if (position >= m_parsed.size() || !m_parsed[position].m_exists)
+            {
+                return m_missing;
+            }
+            return m_parsed[position];
+        }
+
+        /// @brief Prepares one empty slot per argument of parser
+        /// @param argumentsCount count of arguments in ArgumentParser::m_arguments
+        /// @param names map of all argument names to their index, shared with parser
+        void Init(const size_t argumentsCount, const std::shared_ptr<const std::map<std::string, size_t>>& names)
+        {
+            Reset();
+            if (m_parsed.size() > argumentsCount)
+            {
+                m_parsed.erase(m_parsed.begin() + argumentsCount, m_parsed.end());
+            }
+            m_parsed.reserve(argumentsCount);
+            while (m_parsed.size() < argumentsCount)
+            {
+                m_parsed.push_back(ArgumentParsed(m_resource));
+            }
+            if (m_names != names)
+            {
+                m_names = names;
+            }
+        }
+
+        void SetValid()
+        {
+            m_isValid = true;
         }
-        
-        /// @brief vector of strings to validate arguments input data.
-        /// Empty by default. Will fail parsing if string not is in input list
-        std::vector<std::string> m_choicesString = {};
 
-        /// @brief Handy setter of valid choices for arguments with string type
-        /// @param choices vector or initializer list of valid strings
-        /// @return reference to current argument
-        Argument& SetChoices(const std::vector<std::string>& choices)
+        void SetErrorString(const std::string& error)
         {
-            if (m_type != ArgTypeCast::e_String)
+            for (auto& arg : m_parsed)
             {
-                throw std::runtime_error("wrong type");
+                ReleaseSlot(arg);
             }
-            m_choicesString = choices;
-            return *this;
+            m_parsedCount = 0;
+            m_error = error;
         }
 
-        /// @brief vector of integers to validate arguments input data.
-        /// Empty by default. Will fail parsing if ints not is in input list
-        std::vector<int> m_choicesInt = {};
-
-        /// @brief Handy setter of valid choices for arguments with int type
-        /// @param choices vector or initializer list of valid ints
-        /// @return reference to current argument
-        Argument& SetChoices(const std::vector<int>& choices)
+        /// @brief Empties slot, string values are moved to pool to reuse their buffers
+        /// @param arg slot from m_parsed
+        void ReleaseSlot(ArgumentParsed& arg)
         {
-            if (m_type != ArgTypeCast::e_int)
+            if (arg.m_values.GetType() == ArgTypeCast::e_String)
             {
-                throw std::runtime_error("wrong type");
+                ValuesOf<std::string>& strings = arg.m_values.Values<std::string>();
+                for (auto& value : strings)
+                {
+                    m_stringPool.push_back(std::move(value));
+                }
             }
-            m_choicesInt = choices;
-            return *this;
+            arg.m_values.Clear();
+            arg.m_lazyPending.Store(false);
+            arg.m_lazyText.clear();
+            arg.m_lazyEnds.clear();
+            arg.m_exists = false;
+            arg.m_count = 0;
         }
 
-        /// @brief vector of long longs to validate arguments input data.
-        /// Empty by default. Will fail parsing if long longs not is in input list
-        std::vector<long long> m_choicesLongLong = {};
+        /// @brief Appends string value to slot, takes buffer from pool if there is any
+        /// @param arg slot from m_parsed
+        /// @param value string value
+        void PushString(ArgumentParsed& arg, StringView value)
+        {
+            ValuesOf<std::string>& strings = arg.m_values.Values<std::string>();
+            if (m_stringPool.empty())
+            {
+                strings.emplace_back(value.data(), value.size());
+                return;
+            }
+            strings.push_back(std::move(m_stringPool.back()));
+            m_stringPool.pop_back();
+            strings.back().assign(value.data(), value.size());
+        }
 
-        /// @brief Handy setter of valid choices for arguments with long long type
-        /// @param choices vector or initializer list of valid long longs
-        /// @return reference to current argument
-        Argument& SetChoices(const std::vector<long long>& choices)
+        /// @brief Function which marks argument slot as existing one
+        /// @param argObj argument object from ArgumentParser::m_arguments
+        /// @param position index of argument in ArgumentParser::m_arguments
+        /// @return reference to slot
+        ArgumentParsed& MarkExists(const Argument& argObj, const size_t position)
         {
-            if (m_type != ArgTypeCast::e_longlong)
+            ArgumentParsed& arg = m_parsed[position];
+            arg.m_exists = true;
+            arg.m_count = 0;
+            arg.m_values.Reset(argObj.m_type);
+            arg.m_lazyPending.Store(false);
+            arg.m_lazyText.clear();
+            arg.m_lazyEnds.clear();
+            if (argObj.m_boundToVector)
             {
-                throw std::runtime_error("wrong type");
+                ClearBoundVector(argObj);
             }
-            m_choicesLongLong = choices;
-            return *this;
+            ++m_parsedCount;
+            return arg;
         }
 
-        /// @brief vector of double to validate arguments input data.
-        /// Empty by default. Will fail parsing if double not is in input list
-        std::vector<double> m_choicesDouble = {};
+        /// @brief Clears vector bound to argument by Argument::BindTo
+        /// @param argObj argument object from ArgumentParser::m_arguments
+        void ClearBoundVector(const Argument& argObj)
+        {
+            switch (argObj.m_type)
+            {
+            case ArgTypeCast::e_bool:
+                static_cast<std::vector<bool>*>(argObj.m_bound)->clear();
+                break;
+            case ArgTypeCast::e_int:
+                static_cast<std::vector<int>*>(argObj.m_bound)->clear();
+                break;
+            case ArgTypeCast::e_longlong:
+                static_cast<std::vector<long long>*>(argObj.m_bound)->clear();
+                break;
+            case ArgTypeCast::e_double:
+                static_cast<std::vector<double>*>(argObj.m_bound)->clear();
+                break;
+            case ArgTypeCast::e_String:
+            default:
+                static_cast<std::vector<std::string>*>(argObj.m_bound)->clear();
+                break;
+            }
+        }
 
-        /// @brief Handy setter of valid choices for arguments with double type
-        /// @param choices vector or initializer list of valid double
-        /// @return reference to current argument
-        Argument& SetChoices(const std::vector<double>& choices)
+        /// @brief Resets variable bound to argument which is absent in input and has no default.
+        /// Vector is cleared, variable is value initialized, so bound flag becomes false.
+        /// @param argObj argument object from ArgumentParser::m_arguments
+        void ResetBound(const Argument& argObj)
         {
-            if (m_type != ArgTypeCast::e_double)
+            if (argObj.m_boundToVector)
             {
-                throw std::runtime_error("wrong type");
+                ClearBoundVector(argObj);
+                return;
+            }
+            switch (argObj.m_type)
+            {
+            case ArgTypeCast::e_bool:
+                *static_cast<bool*>(argObj.m_bound) = false;
+                break;
+            case ArgTypeCast::e_int:
+                *static_cast<int*>(argObj.m_bound) = 0;
+                break;
+            case ArgTypeCast::e_longlong:
+                *static_cast<long long*>(argObj.m_bound) = 0;
+                break;
+            case ArgTypeCast::e_double:
+                *static_cast<double*>(argObj.m_bound) = 0.0;
+                break;
+            case ArgTypeCast::e_String:
+            default:
+                static_cast<std::string*>(argObj.m_bound)->clear();
+                break;
             }
-            m_choicesDouble = choices;
-            return *this;
         }
 
-        /// @brief Handy setter for single default argument of bool type
-        /// @param defaultArg default boolean value
-        /// @return reference to current argument
-        Argument& SetDefault(bool defaultArg)
+        /// @brief Passes converted value to sink or bound variable if any, otherwise stores it in result
+        /// @param argObj argument object from ArgumentParser::m_arguments
+        /// @param arg slot from m_parsed
+        /// @param value converted value
+        template<typename T>
+        void StoreValue(const Argument& argObj, ArgumentParsed& arg, const T& value)
         {
-            if (m_type != ArgTypeCast::e_bool)
+            if (argObj.m_sink)
             {
-                throw std::runtime_error("wrong type");
+                argObj.m_sink(&value);
+            }
+            else if (argObj.m_bound == nullptr)
+            {
+                arg.m_values.Values<T>().push_back(value);
+            }
+            else if (argObj.m_boundToVector)
+            {
+                static_cast<std::vector<T>*>(argObj.m_bound)->push_back(value);
+            }
+            else
+            {
+                *static_cast<T*>(argObj.m_bound) = value;
             }
-            m_defaultBool.push_back(defaultArg);
-            m_hasDefault = true;
-            return *this;
         }
 
-        /// @brief Handy setter for single default argument of int type
-        /// @param defaultArg default int value
-        /// @return reference to current argument
-        Argument& SetDefault(int defaultArg)
+        /// @brief Passes string value to sink or bound variable if any, otherwise stores it in result
+        /// @param argObj argument object from ArgumentParser::m_arguments
+        /// @param arg slot from m_parsed
+        /// @param value string value
+        void StoreString(const Argument& argObj, ArgumentParsed& arg, StringView value)
         {
-            if (m_type != ArgTypeCast::e_int)
+            if (argObj.m_sink)
             {
-                throw std::runtime_error("wrong type");
+                argObj.m_sink(&value);
+            }
+            else if (argObj.m_bound == nullptr)
+            {
+                PushString(arg, value);
+            }
+            else if (argObj.m_boundToVector)
+            {
+                static_cast<std::vector<std::string>*>(argObj.m_bound)->emplace_back(value.data(), value.size());
+            }
+            else
+            {
+                static_cast<std::string*>(argObj.m_bound)->assign(value.data(), value.size());
             }
-            m_defaultInt.push_back(defaultArg);
-            m_hasDefault = true;
-            return *this;
         }
 
-        /// @brief Handy setter for single default argument of long long type
-        /// @param defaultArg default long long value
-        /// @return reference to current argument
-        Argument& SetDefault(long long defaultArg)
+        /// @brief Writes default values of argument to sink or bound variable
+        /// @param argObj argument object from ArgumentParser::m_arguments
+        /// @param arg slot from m_parsed
+        template<typename T>
+        void StoreDefaults(const Argument& argObj, ArgumentParsed& arg)
         {
-            if (m_type != ArgTypeCast::e_longlong)
+            for (const auto& value : argObj.m_default.Values<T>())
             {
-                throw std::runtime_error("wrong type");
+                StoreValue<T>(argObj, arg, value);
             }
-            m_defaultLongLong.push_back(defaultArg);
-            m_hasDefault = true;
-            return *this;
         }
 
-        /// @brief Handy setter for single default argument of double type
-        /// @param defaultArg default double value
-        /// @return reference to current argument
-        Argument& SetDefault(double defaultArg)
+        /// @brief Internal function to fill argument if default is argument absent
+        /// @param argObj argument object in ArgumentParser::m_arguments
+        /// @param position index of argument in ArgumentParser::m_arguments
+        void ParseDefault(const Argument& argObj, const size_t position)
         {
-            if (m_type != ArgTypeCast::e_double)
+            ARGPARSE_STATS(detail::StatsTimer defaultsTimer(m_stats.defaultsNs); ++m_stats.defaults;)
+            ArgumentParsed& arg = MarkExists(argObj, position);
+
+            if (argObj.m_default.GetType() != argObj.m_type)
             {
-                throw std::runtime_error("wrong type");
+                return;
             }
-            m_defaultDouble.push_back(defaultArg);
-            m_hasDefault = true;
-            return *this;
+
+            if (argObj.m_type == ArgTypeCast::e_String)
+            {
+                for (const auto& value : argObj.m_default.Values<std::string>())
+                {
+                    StoreString(argObj, arg, StringView(value.data(), value.size()));
+                }
+            }
+            else if (argObj.m_bound == nullptr && !argObj.m_sink)
+            {
+                arg.m_values = argObj.m_default;
+            }
+            else
+            {
+                switch (argObj.m_type)
+                {
+                case ArgTypeCast::e_bool:
+                    StoreDefaults<bool>(argObj, arg);
+                    break;
+                case ArgTypeCast::e_int:
+                    StoreDefaults<int>(argObj, arg);
+                    break;
+                case ArgTypeCast::e_longlong:
+                    StoreDefaults<long long>(argObj, arg);
+                    break;
+                case ArgTypeCast::e_double:
+                default:
+                    StoreDefaults<double>(argObj, arg);
+                    break;
+                }
+            }
+            arg.m_count = argObj.m_default.Size();
         }
 
-        /// @brief Handy setter for single default argument of string type
-        /// @param defaultArg default string value
-        /// @return reference to current argument
-        Argument& SetDefault(std::string defaultArg)
+        /// @brief Function which creates holder for parsing various length arguments
+        /// @param argObj argument object from ArgumentParser::m_arguments
+        /// @param position index of argument in ArgumentParser::m_arguments
+        /// @return true if the operation succeeded; false otherwise
+        void CreateParcingStub(const Argument& argObj, const size_t position)
         {
-            if (m_type != ArgTypeCast::e_String)
+            if (!m_parsed[position].m_exists)
             {
-                throw std::runtime_error("wrong type");
+                MarkExists(argObj, position);
             }
-            m_defaultString.push_back(defaultArg);
-            m_hasDefault = true;
-            return *this;
         }
 
-        /// @brief Handy setter for vector of default arguments of bool type
-        /// @param defaultArg vector of default boolean values
-        /// @return reference to current argument
-        Argument& SetDefault(const std::vector<bool>& defaultArg)
+        /// @brief Actual function which parses argument from command line
+        /// @param argObj argument object from ArgumentParser::m_arguments
+        /// @param position index of argument in ArgumentParser::m_arguments
+        /// @param token token from command line input
+        /// @return true if the operation succeeded; false otherwise
+        bool Parse(const Argument& argObj, const size_t position, StringView token)
         {
-            if (m_type != ArgTypeCast::e_bool)
+            ArgumentParsed* argument = &m_parsed[position];
+            if (!argument->m_exists)
             {
-                throw std::runtime_error("wrong type");
+                MarkExists(argObj, position);
+                if (argObj.m_nargs == 0 && argObj.m_bound != nullptr && !argObj.m_boundToVector && argObj.m_type == ArgTypeCast::e_bool)
+                {
+                    *static_cast<bool*>(argObj.m_bound) = true;
+                }
+                return true;
+            }
+
+            if (argObj.m_lazy && argObj.m_nargs != 0)
+            {
+                return RecordLazy(argObj, *argument, token);
+            }
+
+            ARGPARSE_STATS(detail::StatsTimer conversionTimer(m_stats.conversionNs); ++m_stats.conversions;)
+            if (argument->m_values.GetType() == ArgTypeCast::e_String)
+            {
+                if (argObj.m_nargs != 0)
+                {
+                    if (!InChoices(argObj, token))
+                    {
+                        return InvalidateArgsOutOfChoice(argObj, token);
+                    }
+                    StoreString(argObj, *argument, token);
+                }
+                else
+                {
+                    return InvalidateArgsTooMany(argObj);
+                }
+            }
+            else if (argument->m_values.GetType() == ArgTypeCast::e_bool)
+            {
+                if (argObj.m_nargs != 0)
+                {
+                    if (token == "True" || token == "TRUE" || token == "true")
+                    {
+                        StoreValue(argObj, *argument, true);
+                    }
+                    else if (token == "False" || token == "FALSE" || token == "false")
+                    {
+                        StoreValue(argObj, *argument, false);
+                    }
+                    else
+                    {
+                        return InvalidateArgsCannotParse(argObj, token);
+                    }
+                }
+                else
+                {
+                    return InvalidateArgsTooMany(argObj);
+                }
+            }
+            else if (argument->m_values.GetType() == ArgTypeCast::e_int)
+            {
+                if (argObj.m_nargs != 0)
+                {
+                    int value = 0;
+                    if (detail::parseInteger(token, value) != detail::ConversionResult::e_Ok)
+                    {
+                        return InvalidateArgsCannotParse(argObj, token);
+                    }
+
+                    if (!InChoices(argObj, value))
+                    {
+                        return InvalidateArgsOutOfChoice(argObj, token);
+                    }
+                    StoreValue(argObj, *argument, value);
+                }
+                else
+                {
+                    return InvalidateArgsTooMany(argObj);
+                }
+            }
+            else if (argument->m_values.GetType() == ArgTypeCast::e_longlong)
+            {
+                if (argObj.m_nargs != 0)
+                {
+                    long long value = 0;
+                    if (detail::parseInteger(token, value) != detail::ConversionResult::e_Ok)
+                    {
+                        return InvalidateArgsCannotParse(argObj, token);
+                    }
+
+                    if (!InChoices(argObj, value))
+                    {
+                        return InvalidateArgsOutOfChoice(argObj, token);
+                    }
+                    StoreValue(argObj, *argument, value);
+                }
+                else
+                {
+                    return InvalidateArgsTooMany(argObj);
+                }
+            }
+            else if (argument->m_values.GetType() == ArgTypeCast::e_double)
+            {
+                if (argObj.m_nargs != 0)
+                {
+                    if (isNumber(token))
+                    {
+                        double value = 0;
+                        if (detail::parseDouble(token, value) != detail::ConversionResult::e_Ok)
+                        {
+                            return InvalidateArgsCannotParse(argObj, token);
+                        }
+
+                        if (!InChoices(argObj, value))
+                        {
+                            return InvalidateArgsOutOfChoice(argObj, token);
+                        }
+                        StoreValue(argObj, *argument, value);
+                    }
+                    else
+                    {
+                        return InvalidateArgsCannotParse(argObj, token);
+                    }
+                }
+                else
+                {
+                    return InvalidateArgsTooMany(argObj);
+                }
             }
-            m_defaultBool = defaultArg;
-            m_hasDefault = true;
-            return *this;
-        }
 
-        /// @brief Handy setter for vector of default arguments of int type
-        /// @param defaultArg vector of default int values
-        /// @return reference to current argument
-        Argument& SetDefault(const std::vector<int>& defaultArg)
-        {
-            if (m_type != ArgTypeCast::e_int)
-            {
-                throw std::runtime_error("wrong type");
-            }
-            m_defaultInt = defaultArg;
-            m_hasDefault = true;
-            return *this;
+            argument->m_count += 1;
+            return true;
         }
 
-        /// @brief Handy setter for vector of default arguments of long long type
-        /// @param defaultArg vector of default long values
-        /// @return reference to current argument
-        Argument& SetDefault(const std::vector<long long>& defaultArg)
+        /// @brief Keeps token of lazy argument for conversion on first access, checks only its syntax,
+        /// so only overflow and choices are checked later
+        /// @param argObj argument object from ArgumentParser::m_arguments
+        /// @param arg slot from m_parsed
+        /// @param token token from command line input
+        /// @return false if token is not a number of argument type
+        bool RecordLazy(const Argument& argObj, ArgumentParsed& arg, StringView token)
         {
-            if (m_type != ArgTypeCast::e_longlong)
+            const bool integer = argObj.m_type == ArgTypeCast::e_int || argObj.m_type == ArgTypeCast::e_longlong;
+            if (integer ? !detail::isIntegerSyntax(token) : !isNumber(token))
             {
-                throw std::runtime_error("wrong type");
+                return InvalidateArgsCannotParse(argObj, token);
             }
-            m_defaultLongLong = defaultArg;
-            m_hasDefault = true;
-            return *this;
-        }
-
-        /// @brief Handy setter for vector of default arguments of double type
-        /// @param defaultArg vector of default double values
-        /// @return reference to current argument
-        Argument& SetDefault(const std::vector<double>& defaultArg)
-        {
-            if (m_type != ArgTypeCast::e_double)
+            arg.m_lazyText.append(token.data(), token.size());
+            arg.m_lazyEnds.push_back(arg.m_lazyText.size());
+            if (arg.m_lazyArgument != argObj.m_lazyCopy)
             {
-                throw std::runtime_error("wrong type");
+                arg.m_lazyArgument = argObj.m_lazyCopy;
             }
-            m_defaultDouble = defaultArg;
-            m_hasDefault = true;
-            return *this;
+            arg.m_lazyPending.Store(true);
+            arg.m_count += 1;
+            return true;
         }
 
-        /// @brief Handy setter for vector of default arguments of string type
-        /// @param defaultArg vector of default string values
-        /// @return reference to current argument
-        Argument& SetDefault(const std::vector<std::string>& defaultArg)
+        /// @brief Checks value against choices of argument
+        /// @return true if argument has no choices or value is one of them
+        template<typename T>
+        bool InChoices(const Argument& argObj, T value)
         {
-            if (m_type != ArgTypeCast::e_String)
+            if (!argObj.HasChoices())
             {
-                throw std::runtime_error("wrong type");
+                return true;
             }
-            m_defaultString = defaultArg;
-            m_hasDefault = true;
-            return *this;
+            ARGPARSE_STATS(detail::StatsTimer choiceTimer(m_stats.choiceNs); ++m_stats.choiceChecks;)
+            return argObj._inChoices(value);
         }
 
-
-        /// @brief Getter to indicate does argument has any default value
-        /// @return reference to current argument
-        bool HasDefault() const
+        /// @brief Helper function that puts error about argument is out of choices list
+        /// @param argObj Argument for which parsing error is generated
+        /// @param token token which is not in the list
+        /// @return false
+        bool InvalidateArgsOutOfChoice(const argparse::Argument& argObj, StringView token)
         {
-            return m_hasDefault;
-        }
-
-    private:
-        bool                     m_hasDefault = false;
-        std::vector<bool>        m_defaultBool = {};
-        std::vector<int>         m_defaultInt = {};
-        std::vector<long long>   m_defaultLongLong = {};
-        std::vector<double>      m_defaultDouble = {};
-        std::vector<std::string> m_defaultString = {};
-
-        friend ArgumentsObject;
-    };
-
-    /// @brief Helper function to create named argument
-    /// @param shortName Short name if needed. Will be used with single prefix.
-    /// Short name could be auto-generated if possible when m_allowAbbrev in ArgymentParsed set to true)
-    /// @param longName Full name of argument
-    /// @param argsCount Count of arguments
-    /// (use kFromOneToInfinteArgCount or kAnyArgCount for various arguments count)
-    /// @param argType e_String, e_int, e_longlong, e_double, e_bool
-    /// @param required Marker if argument should be passed or ignored if missed.
-    /// @param help Initial part of help for current argument in case of auto-generated help.
-    /// @return instance of Argument
-    Argument CreateNamedArgument(const std::string& shortName = "",
-        const std::string& longName = "",
-        const int argsCount = 1,
-        ArgTypeCast argType = ArgTypeCast::e_String,
-        const bool required = true,
-        const std::string& help = "")
-    {
-        return Argument::CreateNamedArgument(shortName, longName, argsCount, argType, required, help);
-    }
+            const std::string& name = argObj.m_longName.empty() ? (argObj.m_shortName.empty() ? argObj.m_positionalName : argObj.m_shortName) : argObj.m_longName;
 
-    /// @brief Helper function to create positional argument
-    /// @param positionalName Name of positional argument to access from code.
-    /// @param argsCount Count of arguments
-    /// (use kFromOneToInfinteArgCount or kAnyArgCount for various arguments count)
-    /// @param argType e_String, e_int, e_longlong, e_double, e_bool
-    /// @param required Marker if argument should be passed or ignored if missed.
-    /// @param help Initial part of help for current argument in case of auto-generated help.
-    /// @return instance of Argument
-    Argument CreatePositionalArgument(const std::string& positionalName = "",
-        const int argsCount = 1,
-        ArgTypeCast argType = ArgTypeCast::e_String,
-        const bool required = true,
-        const std::string& help = "")
-    {
-        return Argument::CreatePositionalArgument(positionalName, argsCount, argType, required, help);
-    }
+            SetErrorString("Value '" + std::string(token) + "' is out of choices for \"" + name + "\"");
 
-    /// @brief Class which represent actual parsed argument in case of successfully parsing
-    class ArgumentParsed
-    {
-    public:
-        /// @brief Does argument exists. Needed to check in case when argument is not required
-        /// @return bool value
-        bool GetArgumentExists()
-        {
-            return m_exists;
+            return false;
         }
 
-        /// @brief get actual count of argument, in case of various arguments count.
-        /// @return 
-        size_t GetArgumentCount()
+        /// @brief Helper function that puts error about argument has too many inputs
+        /// @param argObj Argument for which parsing error is generated
+        /// @return false
+        bool InvalidateArgsTooMany(const argparse::Argument& argObj)
         {
-            return m_count;
-        }
+            const std::string& name = argObj.m_longName.empty() ? (argObj.m_shortName.empty() ? argObj.m_positionalName : argObj.m_shortName) : argObj.m_longName;
 
-        /// @brief Get result as single bool for bool type arguments. Added for c++11 support.
-        /// Starting from c++17 you can use Get()
-        /// @return bool value of argument
-        const bool GetAsBool() const
-        {
-            return m_bool.front();
-        }
+            SetErrorString("too many argument for \"" + name + "\"");
 
-        /// @brief Get result as single int for int type arguments. Added for c++11 support.
-        /// Starting from c++17 you can use Get()
-        /// @return int value of argument
-        const int GetAsInt() const
-        {
-            return m_int.front();
+            return false;
         }
 
-        /// @brief Get result as single long long for long long type arguments. Added for c++11 support.
-        /// Starting from c++17 you can use Get()
-        /// @return long long value of argument
-        const long long GetAsLongLong() const
+        /// @brief Helper function that puts error about argument has too many inputs
+        /// @param argObj Argument for which parsing error is generated
+        /// @param token token which cannot be parsed by argument rules
+        /// @return false
+        bool InvalidateArgsCannotParse(const argparse::Argument& argObj, StringView token)
         {
-            return m_longLong.front();
-        }
+            const std::string& name = argObj.m_longName.empty() ? (argObj.m_shortName.empty() ? argObj.m_positionalName : argObj.m_shortName) : argObj.m_longName;
 
+            SetErrorString("cannot parse [\"" + std::string(token) + "\"] for  argument \"" + name + "\"");
 
-        /// @brief Get result as single double for double type arguments. Added for c++11 support.
-        /// Starting from c++17 you can use Get()
-        /// @return double value of argument
-        const double GetAsDouble() const
-        {
-            return m_double.front();
+            return false;
         }
 
+        bool m_isValid = false;
+        std::string m_error;
+        /// @brief resource of all containers of result
+        detail::MemoryResource* m_resource;
+        /// @brief one slot per argument of parser, ArgumentParsed::m_exists marks filled slots
+        ValueVector<ArgumentParsed> m_parsed;
+        /// @brief buffers of string values from previous parse, reused by PushString
+        ValueVector<ValueString> m_stringPool;
+        /// @brief scratch list of positional tokens, kept to reuse its capacity
+        ValueVector<StringView> m_positionalTokens;
+        /// @brief count of filled slots in m_parsed
+        size_t m_parsedCount = 0;
+#ifdef ARGPARSE_ENABLE_STATS
+        /// @brief timings and counters of last parse
+        ParseStats m_stats;
+#endif
+        /// @brief all names of arguments to their index, shared between parser and results
+        std::shared_ptr<const std::map<std::string, size_t>> m_names;
+        /// @brief empty result returned for unknown or absent arguments
+        ArgumentParsed m_missing;
+        /// @brief name of subcommand met in input
+        std::string m_subcommand;
+        /// @brief result of subcommand parser, holds at most one element.
+        /// Vector gives deep copy of result and keeps its memory between ParseInto calls.
+        std::vector<ArgumentsObject> m_subcommandArgs;
 
-        /// @brief Get result as single string for string type arguments. Added for c++11 support.
-        /// Starting from c++17 you can use Get()
-        /// @return string value of argument
-        const std::string& GetAsString() const
-        {
-            return m_string.front();
-        }
+        friend ArgumentParser;
+    };
 
-        /// @brief Get result as vector bool for bool type arguments. Added for c++11 support.
-        /// Starting from c++17 you can use Get()
-        /// @return vector bool value of argument
-        const std::vector<bool>& GetAsVecBool() const
-        {
-            return m_bool;
-        }
 
-        /// @brief Get result as vector int for int type arguments. Added for c++11 support.
-        /// Starting from c++17 you can use Get()
-        /// @return vector int value of argument
-        const std::vector<int>& GetAsVecInt() const
-        {
-            return m_int;
-        }
+    /// @brief Main class of argument parser
+    /// hold all user arguments from code and orchestrate other classes 
+    /// in order to parse command line input
+    class ArgumentParser
+    {
+    public:
+        /// @brief Constructor for ArgumentParser
+        /// @param name Program name which will appear in auto-generated help
+        /// @return 
+        ArgumentParser(const std::string& name) noexcept
+            : m_name(name)
+        {}
 
-        /// @brief Get result as vector long long for long long type arguments. Added for c++11 support.
-        /// Starting from c++17 you can use Get()
-        /// @return vector long long value of argument
-        const std::vector<long long>& GetAsVecLongLong() const
+        /// @brief Overload default description for auto-generated command line
+        /// @param description Text to display before the argument help ("" by default)
+        /// @return reference to current parser
+        ArgumentParser& SetDescription(const std::string& description) noexcept
         {
-            return m_longLong;
+            m_description = description;
+            return *this;
         }
 
-        /// @brief Get result as vector double for double type arguments. Added for c++11 support.
-        /// Starting from c++17 you can use Get()
-        /// @return vector double value of argument
-        const std::vector<double>& GetAsVecDouble() const
+        /// @brief Allows long options to be abbreviated if the abbreviation is unambiguous,
+        /// e.g. --verb for --verbose, and generates short names from first letter of long names.
+        /// Generated short names exist only in compiled parser: they are dropped when compiled state
+        /// is dropped and generated again by next Freeze, so they never conflict with names added later.
+        /// @param allowAbbrev bool value true for allow (true by default)
+        /// @return reference to current parser
+        ArgumentParser& SetAllowAbbrev(bool allowAbbrev) noexcept
         {
-            return m_double;
+            m_allowAbbrev = allowAbbrev;
+            _invalidate();
+            return *this;
         }
 
-        /// @brief Get result as vector string for string type arguments. Added for c++11 support.
-        /// Starting from c++17 you can use Get()
-        /// @return vector string value of argument
-        const std::vector<std::string>& GetAsVecString() const
+        /// @brief Setter to ignore unknown argument while parsing.
+        /// If false parsing will be failed if parser detected unknown argument.
+        /// @param ignoreUnknownArgs bool value for ignore or not (false by default)
+        /// @return reference to current parser
+        ArgumentParser& SetIgnoreUknownArgs(bool ignoreUnknownArgs) noexcept
         {
-            return m_string;
+            m_ignoreUknownArgs = ignoreUnknownArgs;
+            return *this;
         }
 
-#if __cplusplus > 201402L || _MSVC_LANG > 201402L
-        /// @brief Function to get actual argument value
-        /// @return std::any: could be bool, int, long long, double, string 
-        /// and vector variants of same types regarding of arguments type.
-        std::any Get()
+        /// @brief Add a - h / --help option to the parser
+        /// @param addHelp Flag to add or not (true by default)
+        /// @return reference to current parser
+        ArgumentParser& SetAddHelp(bool addHelp) noexcept
         {
-            switch (m_type)
-            {
-            case argparse::ArgTypeCast::e_String:
-                if (m_count == 1)
-                {
-                    return m_string.front();
-                }
-                return m_string;
-                break;
-            case argparse::ArgTypeCast::e_int:
-                if (m_count == 1)
-                {
-                    return m_int.front();
-                }
-                return m_int;
-                break;
-            case argparse::ArgTypeCast::e_longlong:
-                if (m_count == 1)
-                {
-                    return m_longLong.front();
-                }
-                return m_longLong;
-                break;
-            case argparse::ArgTypeCast::e_double:
-                if (m_count == 1)
-                {
-                    return m_double.front();
-                }
-                return m_double;
-                break;
-            case argparse::ArgTypeCast::e_bool:
-            default:
-                if (m_count == 1)
-                {
-                    return m_bool.front();
-                }
-                return m_bool;
-                break;
-            }
-        }
-
-#endif // __cplusplus >= 
-
-
-    protected:
+            m_addHelp = addHelp;
+            _invalidate();
+            return *this;
+        }
 
-        ArgumentParsed() {}
-        /// @brief flag about is argument exists
-        bool        m_exists{ false };
-        /// @brief type of argument
-        ArgTypeCast m_type{ ArgTypeCast::e_String };
-        /// @brief count of arguments properties
-        size_t      m_count{ 0 };
 
-        /// @brief container of parsed bool arguments
-        std::vector<bool>        m_bool = {};
-        /// @brief container of parse int arguments
-        std::vector<int>         m_int = {};
-        /// @brief container of parsed long long arguments
-        std::vector<long long>   m_longLong = {};
-        /// @brief container of parsed double arguments
-        std::vector<double>      m_double = {};
-        /// @brief container of parsed string arguments
-        std::vector<std::string> m_string = {};
 
-        friend ArgumentsObject;
-    };
+        /// @brief This function allows to set final message after program description and before
+        /// argument list description
+        /// @param epilogue string of epilogue. Automatically adjusting to screen size. (empty by default)
+        /// @return reference to current parser
+        ArgumentParser& SetEpilogue(const std::string& epilogue) noexcept
+        {
+            m_epilogue = epilogue;
+            return *this;
+        }
 
-    /// @brief Cass that carries result of real parsing
-    /// Indicates if parsing is successful and allows to get ArgumentParsed object in that case.
-    /// In case of parsing failure provides error string for first error.
-    class ArgumentsObject
-    {
-    public:
-        /// @brief Indicates if parsing was successful
-        /// @return bool value
-        bool IsArgValid() const
+        /// @brief Program usage examples
+        /// @param usage the string describing the program usage. (default: generated from arguments added to parser)
+        /// @return reference to current parser
+        ArgumentParser& SetUsage(const std::string& usage) noexcept
         {
-            return m_isValid;
+            m_usage = usage;
+            return *this;
         }
 
-        /// @brief Function to get error message in case of parsing failure.
-        /// @return string with error message
-        const std::string& GetErrorString()
+        /// @brief Function to override default prefix. Be careful when you choosing prefix.
+        /// Single prefix will be used for short names of named argument. Double prefix - for long names.
+        /// Positional arguments have no any prefix
+        /// @param charSym character which will be used for prefix. ('-' by default)
+        /// @return 
+        ArgumentParser& SetPrefixChars(const char charSym) noexcept
         {
-            return m_error;
+            m_prefix = charSym;
+            _invalidate();
+            return *this;
         }
 
-        /// @brief I don't know when you could need this info
-        /// @return size_t count of successfully parsed arguments
-        const size_t ParsedArgsCount() const
+        /// @brief Enables reading of arguments from files. Token which starts with given character
+        /// is replaced by whitespace separated tokens of file, e.g. "@args.txt".
+        /// Files could refer to other files. Each file is read once, tokens are not copied out of it.
+        /// Files are memory mapped if ARGPARSE_USE_MMAP is defined.
+        /// @param charSym character which marks file name ('\0' by default, which means disabled)
+        /// @return reference to current parser
+        ArgumentParser& SetFromFilePrefixChars(const char charSym) noexcept
         {
-            return m_parsed.size();
+            m_fromFilePrefix = charSym;
+            return *this;
         }
 
-        /// @brief Getter function to get ArgumentParsed object 
-        /// @param name name of argument object, could be short name, long name or positional name
-        /// @return Empty argument if argument with given name doesn't exists or real result if exists.
-        ArgumentParsed GetArg(const std::string& name)
+        /// @brief Configures subcommands added by AddSubparser, e.g. "tool build ..." and "tool deploy ...".
+        /// First token which is not option or value of option and equals to name of subcommand
+        /// selects it, all following tokens are parsed by parser of subcommand.
+        /// @param title title of subcommands list in help
+        /// @param required fail parsing if no subcommand is given (true by default)
+        /// @return reference to current parser
+        ArgumentParser& AddSubparsers(const std::string& title = "subcommands", bool required = true)
         {
-            ArgumentParsed arg = ArgumentParsed();
-            arg.m_exists = false;
-            arg.m_count = 0;
+            m_subparsersTitle = title;
+            m_subparsersRequired = required;
+            return *this;
+        }
 
-            const auto position = m_names.find(name);
-            if (position == m_names.end())
+        /// @brief Registers subcommand. Parser of subcommand is built by factory only when
+        /// subcommand is met in input for the first time, so cost of startup doesn't depend
+        /// on count of subcommands. Built parser is kept and shared by copies of this parser.
+        /// Result of subcommand is available by ArgumentsObject::GetSubcommandArgs.
+        /// @param name name of subcommand
+        /// @param factory function which adds arguments to parser of subcommand, could be called from parsing thread
+        /// @param help help string of subcommand
+        /// @return reference to current parser
+        ArgumentParser& AddSubparser(const std::string& name, const std::function<void(ArgumentParser&)>& factory, const std::string& help = "")
+        {
+            if (name.empty() || name[0] == m_prefix)
             {
-                return arg;
+                throw std::runtime_error("Name of subcommand shouldn't be empty or start with prefix");
             }
-
-            const auto argument = m_parsed.find(position->second);
-            if (argument == m_parsed.end())
+            for (const SubparserStruct& el : m_subparsers)
             {
-                return arg;
+                if (el.name == name)
+                {
+                    throw std::runtime_error("Subcommand " + name + " already exists");
+                }
             }
-
-            return argument->second;
+            m_subparsers.push_back({ name, help, factory, std::make_shared<SubparserEntry>() });
+            _invalidate();
+            return *this;
         }
 
-    private:
-        ArgumentsObject() {}
-
-        void SetValid()
+        /// @brief Enables lazy conversion of int, long long and double values. Parsing only checks
+        /// that tokens look like numbers and keeps them, conversion and choices check run on first
+        /// access of argument through ArgumentParsed getters and result is cached.
+        /// Integer tokens are checked to be sign and digits, so getters throw std::runtime_error
+        /// only if value is out of range of type or is out of choices. Results keep what conversion
+        /// needs, so they can be read after parser is changed or destroyed, also from several threads at once.
+        /// Arguments with sink or bound variable are converted at once.
+        /// @param lazy enable or disable lazy conversion (disabled by default)
+        /// @return reference to current parser
+        ArgumentParser& SetLazyConversion(bool lazy) noexcept
         {
-            m_isValid = true;
+            m_lazyConversion = lazy;
+            _invalidate();
+            return *this;
         }
 
-        void SetErrorString(const std::string& error)
+        /// @brief Enables environment variables for all named arguments without explicit Argument::SetEnv.
+        /// Variable name is prefix and long name in upper case with '-' replaced by '_',
+        /// e.g. prefix "APP_" and argument "max-threads" give "APP_MAX_THREADS".
+        /// @param prefix prefix of variables, empty disables it
+        /// @return reference to current parser
+        ArgumentParser& SetEnvPrefix(const std::string& prefix)
         {
-            m_parsed.clear();
-            m_error = error;
+            m_envPrefix = prefix;
+            _invalidate();
+            return *this;
         }
 
-        /// @brief Internal function to fill argument if default is argument absent
-        /// @param argObj argument object in ArgumentParser::m_arguments
-        /// @param position index of argument in ArgumentParser::m_arguments
-        void ParseDefault(const Argument& argObj, const size_t position)
+        /// @brief Adds configuration file as source of values for named arguments.
+        /// Keys are long names of arguments without prefix, values are parsed as command line tokens.
+        /// Values from files are used if argument is not present in command line, and win over
+        /// SetDefault values. Later added files win over earlier ones. Missing file is skipped.
+        /// Files are read once on Freeze and released after it, only values of known keys are kept.
+        /// Keys of unknown arguments and other sections are skipped without converting them.
+        /// @param path path to file
+        /// @param format format of file
+        /// @param section section (INI) or key of nested object (JSON) to read, empty for top level keys
+        /// @return reference to current parser
+        ArgumentParser& AddConfigFile(const std::string& path, ConfigFormat format = ConfigFormat::e_Ini, const std::string& section = "")
         {
-            ArgumentParsed arg = ArgumentParsed();
-            arg.m_exists = true;
-            arg.m_type = argObj.m_type;
+            m_configFiles.push_back({ path, format, section });
+            _invalidate();
+            return *this;
+        }
 
-            if (argObj.m_type == ArgTypeCast::e_String)
-            {
-                arg.m_string = argObj.m_defaultString;
-                arg.m_count = argObj.m_defaultString.size();
-            }
-            else if (argObj.m_type == ArgTypeCast::e_bool)
+        /// @brief Function to add arguments specification to command line parser
+        /// @param arg Argument instance
+        void AddArgument(const Argument& arg)
+        {
+            if (arg.m_longName.empty() && arg.m_shortName.empty() && arg.m_positionalName.empty())
             {
-                arg.m_bool = argObj.m_defaultBool;
-                arg.m_count = argObj.m_defaultBool.size();
+                throw std::runtime_error("Short,long or positional names of argument are empty.\n"
+                    "At least one name should been specified.");
             }
-            else if (argObj.m_type == ArgTypeCast::e_double)
+            else if (!(arg.m_longName.empty() || arg.m_shortName.empty()) && !arg.m_positionalName.empty())
             {
-                arg.m_double = argObj.m_defaultDouble;
-                arg.m_count = argObj.m_defaultDouble.size();
+                throw std::runtime_error("Positional argument " + arg.m_positionalName + " declared aside with short/long name\n"
+                    "Positional argument shouldn't have any short/long name.");
             }
-            else if (argObj.m_type == ArgTypeCast::e_longlong)
+            else if (arg.HasChoices())
             {
-                arg.m_longLong = argObj.m_defaultLongLong;
-                arg.m_count = argObj.m_defaultLongLong.size();
+                if (arg.m_type == ArgTypeCast::e_bool)
+                {
+                    throw std::runtime_error("No need to declare choice for bool type");
+                }
+                else if (arg.m_type == ArgTypeCast::e_int && arg.m_choicesDouble.size() + arg.m_choicesLongLong.size() + arg.m_choicesString.size())
+                {
+                    throw std::runtime_error("Only int choices should been declared");
+                }
+                else if (arg.m_type == ArgTypeCast::e_longlong && arg.m_choicesDouble.size() + arg.m_choicesInt.size() + arg.m_choicesString.size())
+                {
+                    throw std::runtime_error("Only long long choices should been declared");
+                }
+                else if (arg.m_type == ArgTypeCast::e_double && arg.m_choicesInt.size() + arg.m_choicesLongLong.size() + arg.m_choicesString.size())
+                {
+                    throw std::runtime_error("Only double choices should been declared");
+                }
+                else if (arg.m_type == ArgTypeCast::e_String && arg.m_choicesInt.size() + arg.m_choicesLongLong.size() + arg.m_choicesDouble.size())
+                {
+                    throw std::runtime_error("Only string choices should been declared");
+                }
             }
-            else if (argObj.m_type == ArgTypeCast::e_int)
+            if (arg.IsBound() && arg.m_boundType != arg.m_type)
             {
-                arg.m_int = argObj.m_defaultInt;
-                arg.m_count = argObj.m_defaultInt.size();
+                throw std::runtime_error("Type of bound variable doesn't match type of argument");
             }
-
-            m_parsed.emplace(position, arg);
-            if (!argObj.m_shortName.empty())
+            if (arg.HasSink() && arg.m_sinkType != arg.m_type)
             {
-                m_names[argObj.m_shortName] = position;
+                throw std::runtime_error("Type of sink doesn't match type of argument");
             }
-            if (!argObj.m_longName.empty())
+            if (arg.HasSink() && arg.IsBound())
             {
-                m_names[argObj.m_longName] = position;
+                throw std::runtime_error("Argument can't be bound and have sink at once");
             }
-            if (!argObj.m_positionalName.empty())
+            _invalidate();
+            _addArg(arg);
+        }
+
+        /// @brief Function to add arguments specification and get typed handle for it.
+        /// Handle gives access to result without name lookup: result[handle].
+        /// @tparam T type of argument values, should match arg.m_type
+        /// @param arg Argument instance
+        /// @return handle of added argument
+        template<typename T>
+        ArgHandle<T> AddArgument(const Argument& arg)
+        {
+            if (arg.m_type != ArgTypeOf<T>::kValue)
             {
-                m_names[argObj.m_positionalName] = position;
+                throw std::runtime_error("wrong type");
             }
+            AddArgument(arg);
+            return ArgHandle<T>(m_arguments.size() - 1);
         }
 
-        /// @brief Function which creates holder for parsing various length arguments
-        /// @param argObj argument object from ArgumentParser::m_arguments
-        /// @param position index of argument in ArgumentParser::m_arguments
-        /// @return true if the operation succeeded; false otherwise
-        void CreateParcingStub(const Argument& argObj, const size_t position)
+        /// @brief Builds everything parsing depends on: prefixed names table,
+        /// help argument (if m_addHelp), auto-generated short names and index of long names for abbreviations (if m_allowAbbrev).
+        /// ParseArgs calls it on demand, so explicit call is needed only to pay this cost
+        /// before the first parse. Any later AddArgument or setter which affects names
+        /// drops compiled state and next ParseArgs will compile it again.
+        /// @return reference to current parser
+        ArgumentParser& Freeze()
         {
-            const auto argument = m_parsed.find(position);
-            if (argument == m_parsed.end())
+            if (m_frozen)
+            {
+                return *this;
+            }
+            ARGPARSE_STATS(m_buildNs = 0; detail::StatsTimer buildTimer(m_buildNs);)
+
+            std::string _pref{ m_prefix };
+            std::string _doublePref{ m_prefix, m_prefix };
+
+            m_knownArgumentNamesInternal.clear();
+            for (auto& el : m_knownArgumentNames)
             {
-                ArgumentParsed arg = ArgumentParsed();
-                arg.m_exists = true;
-                arg.m_count = 0;
-                arg.m_type = argObj.m_type;
-                m_parsed.emplace(position, arg);
-                if (!argObj.m_shortName.empty())
+                if (el.second.argNameType == KnownNameType::e_Short)
                 {
-                    m_names[argObj.m_shortName] = position;
+                    m_knownArgumentNamesInternal[_pref + el.first] = el.second;
                 }
-                if (!argObj.m_longName.empty())
+                else
                 {
-                    m_names[argObj.m_longName] = position;
+                    m_knownArgumentNamesInternal[_doublePref + el.first] = el.second;
                 }
-                if (!argObj.m_positionalName.empty())
+            }
+
+            if (m_addHelp)
+            {
+                bool shortHelpAlreadyExists = false, longHelpAlreadyExists = false;
+                auto foundArgObject = m_knownArgumentNamesInternal.find(_pref + "h");
+                shortHelpAlreadyExists = foundArgObject != m_knownArgumentNamesInternal.end();
+                foundArgObject = m_knownArgumentNamesInternal.find(_doublePref + "help");
+                longHelpAlreadyExists = foundArgObject != m_knownArgumentNamesInternal.end();
+                if (!shortHelpAlreadyExists || !longHelpAlreadyExists)
                 {
-                    m_names[argObj.m_positionalName] = position;
+                    Argument arg = Argument::CreateNamedArgument(shortHelpAlreadyExists ? "" : "h", longHelpAlreadyExists ? "" : "help", 0);
+                    arg.SetHelp("Show help!");
+                    arg.SetRequired(false);
+                    _addArg(arg);
+                    m_helpPosition = m_arguments.size() - 1;
+                    if (!shortHelpAlreadyExists)
+                    {
+                        m_knownArgumentNamesInternal[_pref + arg.m_shortName] = { m_arguments.size()-1, KnownNameType::e_Short };
+                    }
+                    if (!longHelpAlreadyExists)
+                    {
+                        m_knownArgumentNamesInternal[_doublePref + arg.m_longName] = { m_arguments.size()-1, KnownNameType::e_Long };
+                    }
                 }
             }
-        }
 
-        /// @brief Actual function which parses argument from command line
-        /// @param argObj argument object from ArgumentParser::m_arguments
-        /// @param position index of argument in ArgumentParser::m_arguments
-        /// @param token token from command line input
-        /// @return true if the operation succeeded; false otherwise
-        bool Parse(const Argument& argObj, const size_t position, const std::string& token)
-        {
-            const auto argument = m_parsed.find(position);
-            if (argument == m_parsed.end())
+            if (m_allowAbbrev)
+            {
+                AddShortNames();
+            }
+
+            std::vector<std::pair<std::string, size_t>> names;
+            std::vector<std::pair<std::string, size_t>> longNames;
+            names.reserve(m_knownArgumentNamesInternal.size());
+            for (auto& el : m_knownArgumentNamesInternal)
             {
-                ArgumentParsed arg = ArgumentParsed();
-                arg.m_exists = true;
-                arg.m_count = 0;
-                arg.m_type = argObj.m_type;
-                m_parsed.emplace(position, arg);
-                if (!argObj.m_shortName.empty())
+                names.emplace_back(el.first, el.second.position);
+                if (m_allowAbbrev && el.second.argNameType == KnownNameType::e_Long)
                 {
-                    m_names[argObj.m_shortName] = position;
+                    longNames.emplace_back(el.first, el.second.position);
                 }
-                if (!argObj.m_longName.empty())
+            }
+            m_namesIndex.Build(names);
+            m_abbrevIndex.Build(std::move(longNames));
+            std::vector<std::string> suggestedNames;
+            suggestedNames.reserve(names.size());
+            for (auto& el : names)
+            {
+                suggestedNames.push_back(std::move(el.first));
+            }
+            m_suggestions.Build(std::move(suggestedNames));
+
+            std::shared_ptr<std::map<std::string, size_t>> resultNames = std::make_shared<std::map<std::string, size_t>>();
+            for (size_t i = 0; i < m_arguments.size(); ++i)
+            {
+                const Argument& arg = m_arguments[i];
+                for (const std::string* name : { &arg.m_shortName, &arg.m_longName, &arg.m_positionalName })
                 {
-                    m_names[argObj.m_longName] = position;
+                    if (!name->empty())
+                    {
+                        (*resultNames)[*name] = i;
+                    }
                 }
-                if (!argObj.m_positionalName.empty())
+            }
+            m_resultNames = resultNames;
+
+            for (Argument& arg : m_arguments)
+            {
+                arg._indexChoices();
+                const bool numeric = arg.m_type == ArgTypeCast::e_int || arg.m_type == ArgTypeCast::e_longlong || arg.m_type == ArgTypeCast::e_double;
+                arg.m_lazy = m_lazyConversion && numeric && !arg.HasSink() && !arg.IsBound();
+                arg.m_lazyCopy.reset();
+                if (arg.m_lazy)
                 {
-                    m_names[argObj.m_positionalName] = position;
+                    arg.m_lazyCopy = std::make_shared<const Argument>(arg);
                 }
-                return true;
             }
 
-            if (argument->second.m_type == ArgTypeCast::e_String)
+            std::vector<std::pair<std::string, size_t>> subcommands;
+            subcommands.reserve(m_subparsers.size());
+            for (size_t i = 0; i < m_subparsers.size(); ++i)
+            {
+                subcommands.emplace_back(m_subparsers[i].name, i);
+            }
+            m_subparsersIndex.Build(subcommands);
+
+            m_streamedPositional = kSizeTypeEnd;
+            if (m_positionalArgumentNames.size() == 1)
+            {
+                const size_t position = m_positionalArgumentNames.front().positionInArguments;
+                const Argument& arg = m_arguments[position];
+                if (arg.HasSink() && (arg.m_nargs == kAnyArgCount || arg.m_nargs == kFromOneToInfinteArgCount))
+                {
+                    m_streamedPositional = position;
+                }
+            }
+
+            _buildEnvIndex();
+            _loadConfigFiles();
+
+            m_frozen = true;
+            return *this;
+        }
+
+        /// @brief Indicates if parser is compiled and ParseArgs will only walk tokens
+        /// @return bool value
+        bool IsFrozen() const noexcept
+        {
+            return m_frozen;
+        }
+
+        // Const overloads of parsing don't modify parser and could be called from many threads
+        // at once. Parser must be frozen before, otherwise std::runtime_error is thrown.
+
+        /// @brief Main function of parsing argument
+        /// @param args vector of input tokens
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        ArgumentsObject ParseArgs(const std::vector<std::string>& args) const
+        {
+            return ParseArgs(args.begin(), args.end());
+        }
+
+        /// @brief Function of parsing argument over any range of string-like tokens
+        /// (const char*, std::string, StringView). Tokens are not copied while parsing,
+        /// only values of arguments are stored.
+        /// @param first iterator to first token
+        /// @param last iterator past the last token
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        template<typename Iterator>
+        ArgumentsObject ParseArgs(Iterator first, Iterator last) const
+        {
+            ArgumentsObject argObj;
+            ParseInto(argObj, first, last);
+            return argObj;
+        }
+
+#ifdef ARGPARSE_HAS_SPAN
+        /// @brief Function of parsing argument over span of C strings, without copying of tokens
+        /// @param args span of input tokens (without program name)
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        ArgumentsObject ParseArgs(std::span<const char*> args) const
+        {
+            return ParseArgs(args.begin(), args.end());
+        }
+#endif // ARGPARSE_HAS_SPAN
+
+        /// @brief This function parses argc and argv directly, program name is skipped
+        /// @param argc count of arguments
+        /// @param argv pointer to array of char*
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        ArgumentsObject ParseArgs(const int argc, char** argv) const
+        {
+            if (argc < 1)
+            {
+                return ParseArgs(argv, argv);
+            }
+            return ParseArgs(argv + 1, argv + argc);
+        }
+
+        /// @brief Parses input into existing result object. Previous values of result are dropped,
+        /// but memory of them is reused, so repeated parsing of similar input doesn't allocate.
+        /// @param result object to fill
+        /// @param args vector of input tokens
+        /// @return true if parsing successful, error could be taken from result otherwise
+        bool ParseInto(ArgumentsObject& result, const std::vector<std::string>& args) const
+        {
+            return ParseInto(result, args.begin(), args.end());
+        }
+
+        /// @brief Parses range of string-like tokens into existing result object
+        /// @param result object to fill. Previous values are dropped, memory is reused.
+        /// @param first iterator to first token
+        /// @param last iterator past the last token
+        /// @return true if parsing successful, error could be taken from result otherwise
+        template<typename Iterator>
+        bool ParseInto(ArgumentsObject& result, Iterator first, Iterator last) const
+        {
+            detail::RangeTokens<Iterator> tokens(first, last);
+            return _parseSource(tokens, result);
+        }
+
+        /// @brief Splits command line string by POSIX shell rules and parses it.
+        /// Tokens are taken as views of string, only quoted or escaped tokens are copied.
+        /// @param commandLine command line without program name, e.g. "-n 5 --name 'some name'"
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        ArgumentsObject ParseCommandLine(StringView commandLine) const
+        {
+            ArgumentsObject argObj;
+            ParseCommandLineInto(argObj, commandLine);
+            return argObj;
+        }
+
+        /// @brief Splits command line string by POSIX shell rules and parses it into existing result object
+        /// @param result object to fill. Previous values are dropped, memory is reused.
+        /// @param commandLine command line without program name
+        /// @return true if parsing successful, error could be taken from result otherwise
+        bool ParseCommandLineInto(ArgumentsObject& result, StringView commandLine) const
+        {
+            detail::CommandLineTokens tokens(commandLine);
+            return _parseSource(tokens, result);
+        }
+
+#ifdef ARGPARSE_HAS_SPAN
+        /// @brief Parses span of C strings into existing result object
+        /// @param result object to fill. Previous values are dropped, memory is reused.
+        /// @param args span of input tokens (without program name)
+        /// @return true if parsing successful, error could be taken from result otherwise
+        bool ParseInto(ArgumentsObject& result, std::span<const char*> args) const
+        {
+            return ParseInto(result, args.begin(), args.end());
+        }
+#endif // ARGPARSE_HAS_SPAN
+
+        /// @brief Parses argc and argv into existing result object, program name is skipped
+        /// @param result object to fill. Previous values are dropped, memory is reused.
+        /// @param argc count of arguments
+        /// @param argv pointer to array of char*
+        /// @return true if parsing successful, error could be taken from result otherwise
+        bool ParseInto(ArgumentsObject& result, const int argc, char** argv) const
+        {
+            if (argc < 1)
+            {
+                return ParseInto(result, argv, argv);
+            }
+            return ParseInto(result, argv + 1, argv + argc);
+        }
+
+        /// @brief Parses many command lines of the same schema in parallel.
+        /// Threads take chunks of lines from shared counter, so slow lines don't stall other threads.
+        /// @tparam Lines random access container of token ranges, e.g. std::vector<std::vector<std::string>>
+        /// @param lines command lines without program name, each one is range of string-like tokens
+        /// or whole command line string which is split by ParseCommandLine rules
+        /// @param threadsCount count of threads, 0 means std::thread::hardware_concurrency()
+        /// @return one ArgumentsObject per line in input order. First exception of any thread is rethrown.
+        template<typename Lines>
+        std::vector<ArgumentsObject> ParseBatch(const Lines& lines, size_t threadsCount = 0) const
+        {
+            const size_t linesCount = lines.size();
+            std::vector<ArgumentsObject> results(linesCount);
+            if (threadsCount == 0)
             {
-                if (argObj.m_nargs != 0)
+                threadsCount = std::thread::hardware_concurrency();
+            }
+            const size_t chunksCount = (linesCount + kBatchChunkSize - 1) / kBatchChunkSize;
+            threadsCount = std::max<size_t>(1, std::min(threadsCount, chunksCount));
+
+            std::atomic<size_t> nextChunk(0);
+            std::exception_ptr error;
+            std::atomic<bool> failed(false);
+            auto worker = [&]()
+            {
+                try
                 {
-                    if (argObj.m_choicesString.size())
+                    for (size_t chunk = nextChunk++; chunk < chunksCount && !failed; chunk = nextChunk++)
                     {
-                        auto it = std::find_if(argObj.m_choicesString.begin(), argObj.m_choicesString.end(),
-                            [&token](const std::string& str) -> bool
-                            {
-                                return token == str;
-                            });
-                        if (it == argObj.m_choicesString.end())
+                        const size_t last = std::min(linesCount, (chunk + 1) * kBatchChunkSize);
+                        for (size_t i = chunk * kBatchChunkSize; i < last; ++i)
                         {
-                            return InvalidateArgsOutOfChoice(argObj, token);
+                            _parseLine(results[i], lines[i]);
                         }
                     }
-                    argument->second.m_string.push_back(token);
-                }
-                else
-                {
-                    return InvalidateArgsTooMany(argObj);
                 }
-            }
-            else if (argument->second.m_type == ArgTypeCast::e_bool)
-            {
-                if (argObj.m_nargs != 0)
+                catch (...)
                 {
-                    if (token == "True" || token == "TRUE" || token == "true")
-                    {
-                        argument->second.m_bool.push_back(true);
-                    }
-                    else if (token == "False" || token == "FALSE" || token == "false")
+                    if (!failed.exchange(true))
                     {
-                        argument->second.m_bool.push_back(false);
-                    }
-                    else
-                    {
-                        return InvalidateArgsCannotParse(argObj, token);
+                        error = std::current_exception();
                     }
                 }
-                else
-                {
-                    return InvalidateArgsTooMany(argObj);
-                }
-            }
-            else if (argument->second.m_type == ArgTypeCast::e_int)
-            {
-                if (argObj.m_nargs != 0)
-                {
-                    if (isNumber(token))
-                    {
-                        try
-                        {
-                            argument->second.m_int.push_back(std::stoi(token));
-
-                            int value = argument->second.m_int.back();
+            };
 
-                            if (argObj.m_choicesInt.size())
-                            {
-                                auto it = std::find_if(argObj.m_choicesInt.begin(), argObj.m_choicesInt.end(),
-                                    [value](const int& integerValue) -> bool
-                                    {
-                                        return value == integerValue;
-                                    });
-                                if (it == argObj.m_choicesInt.end())
-                                {
-                                    return InvalidateArgsOutOfChoice(argObj, token);
-                                }
-                            }
-                        }
-                        catch (...)
-                        {
-                            return InvalidateArgsCannotParse(argObj, token);
-                        }
-                    }
-                    else
-                    {
-                        return InvalidateArgsCannotParse(argObj, token);
-                    }
-                }
-                else
+            std::vector<std::thread> threads;
+            threads.reserve(threadsCount - 1);
+            try
+            {
+                for (size_t i = 1; i < threadsCount; ++i)
                 {
-                    return InvalidateArgsTooMany(argObj);
+                    threads.emplace_back(worker);
                 }
             }
-            else if (argument->second.m_type == ArgTypeCast::e_longlong)
+            catch (const std::system_error&)
             {
-                if (argObj.m_nargs != 0)
-                {
-                    if (isNumber(token))
-                    {
-                        try
-                        {
-                            argument->second.m_longLong.push_back(std::stoll(token));
-
-                            long long value = argument->second.m_int.back();
-
-                            if (argObj.m_choicesLongLong.size())
-                            {
-                                auto it = std::find_if(argObj.m_choicesLongLong.begin(), argObj.m_choicesLongLong.end(),
-                                    [value](const long long& longLongVal) -> bool
-                                    {
-                                        return value == longLongVal;
-                                    });
-                                if (it == argObj.m_choicesLongLong.end())
-                                {
-                                    return InvalidateArgsOutOfChoice(argObj, token);
-                                }
-                            }
-                        }
-                        catch (...)
-                        {
-                            return InvalidateArgsCannotParse(argObj, token);
-                        }
-                    }
-                    else
-                    {
-                        return InvalidateArgsCannotParse(argObj, token);
-                    }
-                }
-                else
-                {
-                    return InvalidateArgsTooMany(argObj);
-                }
+                // not enough resources for all threads, work with already started ones
             }
-            else if (argument->second.m_type == ArgTypeCast::e_double)
+            worker();
+            for (auto& thread : threads)
             {
-                if (argObj.m_nargs != 0)
-                {
-                    if (isNumber(token))
-                    {
-                        try
-                        {
-                            argument->second.m_double.push_back(std::stod(token));
-
-                            double value = argument->second.m_double.back();
-
-                            if (argObj.m_choicesDouble.size())
-                            {
-                                auto it = std::find_if(argObj.m_choicesDouble.begin(), argObj.m_choicesDouble.end(),
-                                    [value](const double& doubleVal) -> bool
-                                    {
-                                        return std::numeric_limits<double>::epsilon() >= abs(doubleVal - value);
-                                    });
-                                if (it == argObj.m_choicesDouble.end())
-                                {
-                                    return InvalidateArgsOutOfChoice(argObj, token);
-                                }
-                            }
-                        }
-                        catch (...)
-                        {
-                            return InvalidateArgsCannotParse(argObj, token);
-                        }
-                    }
-                    else
-                    {
-                        return InvalidateArgsCannotParse(argObj, token);
-                    }
-                }
-                else
-                {
-                    return InvalidateArgsTooMany(argObj);
-                }
+                thread.join();
             }
 
-            argument->second.m_count += 1;
-            return true;
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+            return results;
         }
 
-        /// @brief Helper function that puts error about argument is out of choices list
-        /// @param argObj Argument for which parsing error is generated
-        /// @param token token which is not in the list
-        /// @return false
-        bool InvalidateArgsOutOfChoice(const argparse::Argument& argObj, const std::string& token)
+#ifdef ARGPARSE_USE_PMR
+        /// @brief Main function of parsing argument, result takes memory from given resource
+        /// @param args vector of input tokens
+        /// @param resource memory resource (arena) for values and temporary containers.
+        /// Must outlive returned ArgumentsObject.
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        ArgumentsObject ParseArgs(const std::vector<std::string>& args, std::pmr::memory_resource* resource) const
         {
-            const std::string& name = argObj.m_longName.empty() ? (argObj.m_shortName.empty() ? argObj.m_positionalName : argObj.m_shortName) : argObj.m_longName;
-
-            SetErrorString("Value '" + token + "' is out of choices for \"" + name + "\"");
+            return ParseArgs(args.begin(), args.end(), resource);
+        }
 
-            return false;
+        /// @brief Function of parsing argument over any range of string-like tokens,
+        /// result takes memory from given resource
+        /// @param first iterator to first token
+        /// @param last iterator past the last token
+        /// @param resource memory resource (arena) for values and temporary containers.
+        /// Must outlive returned ArgumentsObject.
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        template<typename Iterator>
+        ArgumentsObject ParseArgs(Iterator first, Iterator last, std::pmr::memory_resource* resource) const
+        {
+            ArgumentsObject argObj(resource);
+            ParseInto(argObj, first, last);
+            return argObj;
         }
 
-        /// @brief Helper function that puts error about argument has too many inputs
-        /// @param argObj Argument for which parsing error is generated
-        /// @return false
-        bool InvalidateArgsTooMany(const argparse::Argument& argObj)
+        /// @brief This function parses argc and argv directly, program name is skipped.
+        /// Result takes memory from given resource
+        /// @param argc count of arguments
+        /// @param argv pointer to array of char*
+        /// @param resource memory resource (arena) for values and temporary containers.
+        /// Must outlive returned ArgumentsObject.
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        ArgumentsObject ParseArgs(const int argc, char** argv, std::pmr::memory_resource* resource) const
         {
-            const std::string& name = argObj.m_longName.empty() ? (argObj.m_shortName.empty() ? argObj.m_positionalName : argObj.m_shortName) : argObj.m_longName;
+            if (argc < 1)
+            {
+                return ParseArgs(argv, argv, resource);
+            }
+            return ParseArgs(argv + 1, argv + argc, resource);
+        }
+#endif // ARGPARSE_USE_PMR
 
-            SetErrorString("too many argument for \"" + name + "\"");
+        // Overloads below compile parser on first call and then parse through const overloads.
+        // They are safe to call concurrently only after parser is frozen.
 
-            return false;
+        /// @brief Main function of parsing argument, compiles parser if needed
+        /// @param args vector of input tokens
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        ArgumentsObject ParseArgs(const std::vector<std::string>& args)
+        {
+            return _compiled().ParseArgs(args);
         }
 
-        /// @brief Helper function that puts error about argument has too many inputs
-        /// @param argObj Argument for which parsing error is generated
-        /// @param token token which cannot be parsed by argument rules
-        /// @return false
-        bool InvalidateArgsCannotParse(const argparse::Argument& argObj, const std::string& token)
+        /// @brief Function of parsing argument over any range of string-like tokens, compiles parser if needed
+        /// @param first iterator to first token
+        /// @param last iterator past the last token
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        template<typename Iterator>
+        ArgumentsObject ParseArgs(Iterator first, Iterator last)
         {
-            const std::string& name = argObj.m_longName.empty() ? (argObj.m_shortName.empty() ? argObj.m_positionalName : argObj.m_shortName) : argObj.m_longName;
-
-            SetErrorString("cannot parse [\"" + token + "\"] for  argument \"" + name + "\"");
-
-            return false;
+            return _compiled().ParseArgs(first, last);
         }
 
-        bool m_isValid = false;
-        std::string m_error;
-        std::map<const size_t, ArgumentParsed>  m_parsed;
-        std::map<const std::string, size_t>     m_names;
+#ifdef ARGPARSE_HAS_SPAN
+        /// @brief Function of parsing argument over span of C strings, compiles parser if needed
+        /// @param args span of input tokens (without program name)
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        ArgumentsObject ParseArgs(std::span<const char*> args)
+        {
+            return _compiled().ParseArgs(args);
+        }
+#endif // ARGPARSE_HAS_SPAN
 
-        friend ArgumentParser;
-    };
+        /// @brief This function parses argc and argv directly, program name is skipped.
+        /// Compiles parser if needed
+        /// @param argc count of arguments
+        /// @param argv pointer to array of char*
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        ArgumentsObject ParseArgs(const int argc, char** argv)
+        {
+            return _compiled().ParseArgs(argc, argv);
+        }
 
+        /// @brief Parses input into existing result object, compiles parser if needed
+        /// @param result object to fill. Previous values are dropped, memory is reused.
+        /// @param args vector of input tokens
+        /// @return true if parsing successful, error could be taken from result otherwise
+        bool ParseInto(ArgumentsObject& result, const std::vector<std::string>& args)
+        {
+            return _compiled().ParseInto(result, args);
+        }
 
-    /// @brief Main class of argument parser
-    /// hold all user arguments from code and orchestrate other classes 
-    /// in order to parse command line input
-    class ArgumentParser
-    {
-    public:
-        /// @brief Constructor for ArgumentParser
-        /// @param name Program name which will appear in auto-generated help
-        /// @return 
-        ArgumentParser(const std::string& name) noexcept
-            : m_name(name)
-        {}
+        /// @brief Parses range of string-like tokens into existing result object, compiles parser if needed
+        /// @param result object to fill. Previous values are dropped, memory is reused.
+        /// @param first iterator to first token
+        /// @param last iterator past the last token
+        /// @return true if parsing successful, error could be taken from result otherwise
+        template<typename Iterator>
+        bool ParseInto(ArgumentsObject& result, Iterator first, Iterator last)
+        {
+            return _compiled().ParseInto(result, first, last);
+        }
 
-        /// @brief Overload default description for auto-generated command line
-        /// @param description Text to display before the argument help ("" by default)
-        /// @return reference to current parser
-        ArgumentParser& SetDescription(const std::string& description) noexcept
+#ifdef ARGPARSE_HAS_SPAN
+        /// @brief Parses span of C strings into existing result object, compiles parser if needed
+        /// @param result object to fill. Previous values are dropped, memory is reused.
+        /// @param args span of input tokens (without program name)
+        /// @return true if parsing successful, error could be taken from result otherwise
+        bool ParseInto(ArgumentsObject& result, std::span<const char*> args)
         {
-            m_description = description;
-            return *this;
+            return _compiled().ParseInto(result, args);
         }
+#endif // ARGPARSE_HAS_SPAN
 
-        /// @brief Allows long options to be abbreviated if the abbreviation is unambiguous.
-        /// @param allowAbbrev bool value true for allow (true by default)
-        /// @return reference to current parser
-        ArgumentParser& SetAllowAbbrev(bool allowAbbrev) noexcept
+        /// @brief Parses argc and argv into existing result object, compiles parser if needed
+        /// @param result object to fill. Previous values are dropped, memory is reused.
+        /// @param argc count of arguments
+        /// @param argv pointer to array of char*
+        /// @return true if parsing successful, error could be taken from result otherwise
+        bool ParseInto(ArgumentsObject& result, const int argc, char** argv)
         {
-            m_allowAbbrev = allowAbbrev;
-            return *this;
+            return _compiled().ParseInto(result, argc, argv);
         }
 
-        /// @brief Setter to ignore unknown argument while parsing.
-        /// If false parsing will be failed if parser detected unknown argument.
-        /// @param ignoreUnknownArgs bool value for ignore or not (false by default)
-        /// @return reference to current parser
-        ArgumentParser& SetIgnoreUknownArgs(bool ignoreUnknownArgs) noexcept
+        /// @brief Splits command line string by POSIX shell rules and parses it, compiles parser if needed
+        /// @param commandLine command line without program name
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        ArgumentsObject ParseCommandLine(StringView commandLine)
         {
-            m_ignoreUknownArgs = ignoreUnknownArgs;
-            return *this;
+            return _compiled().ParseCommandLine(commandLine);
         }
 
-        /// @brief Add a - h / --help option to the parser
-        /// @param addHelp Flag to add or not (true by default)
-        /// @return reference to current parser
-        ArgumentParser& SetAddHelp(bool addHelp) noexcept
+        /// @brief Splits command line string and parses it into existing result object, compiles parser if needed
+        /// @param result object to fill. Previous values are dropped, memory is reused.
+        /// @param commandLine command line without program name
+        /// @return true if parsing successful, error could be taken from result otherwise
+        bool ParseCommandLineInto(ArgumentsObject& result, StringView commandLine)
         {
-            m_addHelp = addHelp;
-            return *this;
+            return _compiled().ParseCommandLineInto(result, commandLine);
         }
 
+        /// @brief Parses many command lines of the same schema in parallel, compiles parser if needed
+        /// @tparam Lines random access container of token ranges, e.g. std::vector<std::vector<std::string>>
+        /// @param lines command lines without program name, each one is range of string-like tokens
+        /// or whole command line string which is split by ParseCommandLine rules
+        /// @param threadsCount count of threads, 0 means std::thread::hardware_concurrency()
+        /// @return one ArgumentsObject per line in input order. First exception of any thread is rethrown.
+        template<typename Lines>
+        std::vector<ArgumentsObject> ParseBatch(const Lines& lines, size_t threadsCount = 0)
+        {
+            return _compiled().ParseBatch(lines, threadsCount);
+        }
 
+#ifdef ARGPARSE_USE_PMR
+        /// @brief Main function of parsing argument into given memory resource, compiles parser if needed
+        /// @param args vector of input tokens
+        /// @param resource memory resource (arena) for values and temporary containers.
+        /// Must outlive returned ArgumentsObject.
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        ArgumentsObject ParseArgs(const std::vector<std::string>& args, std::pmr::memory_resource* resource)
+        {
+            return _compiled().ParseArgs(args, resource);
+        }
 
-        /// @brief This function allows to set final message after program description and before
-        /// argument list description
-        /// @param epilogue string of epilogue. Automatically adjusting to screen size. (empty by default)
-        /// @return reference to current parser
-        ArgumentParser& SetEpilogue(const std::string& epilogue) noexcept
+        /// @brief Function of parsing range of tokens into given memory resource, compiles parser if needed
+        /// @param first iterator to first token
+        /// @param last iterator past the last token
+        /// @param resource memory resource (arena) for values and temporary containers.
+        /// Must outlive returned ArgumentsObject.
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        template<typename Iterator>
+        ArgumentsObject ParseArgs(Iterator first, Iterator last, std::pmr::memory_resource* resource)
         {
-            m_epilogue = epilogue;
-            return *this;
+            return _compiled().ParseArgs(first, last, resource);
         }
 
-        /// @brief Program usage examples
-        /// @param usage the string describing the program usage. (default: generated from arguments added to parser)
-        /// @return reference to current parser
-        ArgumentParser& SetUsage(const std::string& usage) noexcept
+        /// @brief This function parses argc and argv into given memory resource, compiles parser if needed
+        /// @param argc count of arguments
+        /// @param argv pointer to array of char*
+        /// @param resource memory resource (arena) for values and temporary containers.
+        /// Must outlive returned ArgumentsObject.
+        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
+        /// information about errors if not
+        ArgumentsObject ParseArgs(const int argc, char** argv, std::pmr::memory_resource* resource)
         {
-            m_usage = usage;
-            return *this;
+            return _compiled().ParseArgs(argc, argv, resource);
         }
+#endif // ARGPARSE_USE_PMR
 
-        /// @brief Function to override default prefix. Be careful when you choosing prefix.
-        /// Single prefix will be used for short names of named argument. Double prefix - for long names.
-        /// Positional arguments have no any prefix
-        /// @param charSym character which will be used for prefix. ('-' by default)
-        /// @return 
-        ArgumentParser& SetPrefixChars(const char charSym) noexcept
+    private:
+        /// @brief Compiles parser if needed
+        /// @return const view of frozen parser, for delegating to const parsing functions
+        const ArgumentParser& _compiled()
         {
-            m_prefix = charSym;
-            return *this;
+            return Freeze();
         }
 
-        /// @brief Function to add arguments specification to command line parser
-        /// @param arg Argument instance
-        void AddArgument(const Argument& arg)
+        /// @brief Resolves unambiguous prefix of long name, e.g. --verb for --verbose
+        /// @param argObj result of parsing
+        /// @param positionInInput position of token for error message
+        /// @param el token which is not a known name
+        /// @param foundPosition out parameter, index of argument or kNotFound if token is not a prefix
+        /// @return false if prefix is ambiguous, error is set to argObj
+        bool _abbreviationHit(ArgumentsObject& argObj, const size_t positionInInput, StringView el, size_t& foundPosition) const
         {
-            if (arg.m_longName.empty() && arg.m_shortName.empty() && arg.m_positionalName.empty())
+            foundPosition = detail::PerfectHashIndex::kNotFound;
+            if (el.size() <= 2 || el[0] != m_prefix || el[1] != m_prefix)
+            {
+                return true;
+            }
+
+            const size_t found = m_abbrevIndex.Find(el);
+            if (found == detail::PrefixIndex::kAmbiguous)
+            {
+                std::stringstream ss;
+                ss << "Ambiguous input argument: \"" << el << "\" at position " << positionInInput << " could match";
+                const std::vector<StringView> matches = m_abbrevIndex.Matches(el);
+                for (size_t i = 0; i < matches.size(); ++i)
+                {
+                    ss << (i == 0 ? " " : ", ") << matches[i];
+                }
+                argObj.SetErrorString(ss.str());
+                return false;
+            }
+            if (found != detail::PrefixIndex::kNotFound)
             {
-                throw std::runtime_error("Short,long or positional names of argument are empty.\n"
-                    "At least one name should been specified.");
+                foundPosition = found;
             }
-            else if (!(arg.m_longName.empty() || arg.m_shortName.empty()) && !arg.m_positionalName.empty())
+            return true;
+        }
+
+        /// @brief Expands response files if enabled and runs parsing core
+        /// @param tokens source of input tokens
+        /// @param result object to fill
+        /// @return true if parsing successful
+        template<typename TokenSource>
+        bool _parseSource(TokenSource& tokens, ArgumentsObject& result) const
+        {
+            if (m_fromFilePrefix != '\0')
             {
-                throw std::runtime_error("Positional argument " + arg.m_positionalName + " declared aside with short/long name\n"
-                    "Positional argument shouldn't have any short/long name.");
+                detail::ResponseFileTokens<TokenSource> expandedTokens(tokens, m_fromFilePrefix);
+                _parseTokens(expandedTokens, result);
             }
-            else if (arg.m_choicesDouble.size() + arg.m_choicesInt.size() + arg.m_choicesLongLong.size() + arg.m_choicesString.size())
+            else
             {
-                if (arg.m_type == ArgTypeCast::e_bool)
-                {
-                    throw std::runtime_error("No need to declare choice for bool type");
-                }
-                else if (arg.m_type == ArgTypeCast::e_int && arg.m_choicesDouble.size() + arg.m_choicesLongLong.size() + arg.m_choicesString.size())
-                {
-                    throw std::runtime_error("Only int choices should been declared");
-                }
-                else if (arg.m_type == ArgTypeCast::e_longlong && arg.m_choicesDouble.size() + arg.m_choicesInt.size() + arg.m_choicesString.size())
-                {
-                    throw std::runtime_error("Only long long choices should been declared");
-                }
-                else if (arg.m_type == ArgTypeCast::e_double && arg.m_choicesInt.size() + arg.m_choicesLongLong.size() + arg.m_choicesString.size())
-                {
-                    throw std::runtime_error("Only double choices should been declared");
-                }
-                else if (arg.m_type == ArgTypeCast::e_String && arg.m_choicesInt.size() + arg.m_choicesLongLong.size() + arg.m_choicesDouble.size())
-                {
-                    throw std::runtime_error("Only string choices should been declared");
-                }
+                _parseTokens(tokens, result);
             }
-            _addArg(arg);
+            return result.IsArgValid();
         }
 
-        /// @brief Main function of parsing argument
-        /// @param args vector of input tokens
-        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
-        /// information about errors if not
-        ArgumentsObject ParseArgs(const std::vector<std::string>& args)
+        /// @brief Checks if token selects subcommand and parses rest of tokens by its parser
+        /// @param tokens source of input tokens, rest of it is consumed by subcommand
+        /// @param argObj result of parsing
+        /// @param currentArgumentObjectIndex named argument which takes values now
+        /// @param token token which is not option
+        /// @param dispatched out parameter, true if subcommand parsed rest of tokens
+        /// @return false if parsing should stop, error is set to argObj
+        template<typename TokenSource>
+        bool _subcommandHit(TokenSource& tokens, ArgumentsObject& argObj, size_t currentArgumentObjectIndex, StringView token, bool& dispatched) const
         {
-            std::string _pref{ m_prefix };
-            std::string _doublePref{ m_prefix, m_prefix };
+            const bool variadicValue = currentArgumentObjectIndex != kSizeTypeEnd && m_arguments[currentArgumentObjectIndex].m_nargs < 0;
+            if (currentArgumentObjectIndex != kSizeTypeEnd
+                && m_arguments[currentArgumentObjectIndex].m_nargs > 0
+                && argObj.m_parsed[currentArgumentObjectIndex].GetArgumentCount() < static_cast<size_t>(m_arguments[currentArgumentObjectIndex].m_nargs))
+            {
+                // token is value of option
+                return true;
+            }
 
-            for (auto& el : m_knownArgumentNames)
+            const size_t found = m_subparsersIndex.Find(token);
+            if (found == detail::PerfectHashIndex::kNotFound)
             {
-                if (el.second.argNameType == KnownNameType::e_Short)
-                {
-                    m_knownArgumentNamesInternal[_pref + el.first] = el.second;
-                }
-                else
+                if (variadicValue || !m_positionalArgumentNames.empty())
                 {
-                    m_knownArgumentNamesInternal[_doublePref + el.first] = el.second;
+                    return true;
                 }
+                argObj.SetErrorString("Unknown subcommand: \"" + std::string(token) + "\"");
+                return false;
             }
 
-            if (m_addHelp)
+            const SubparserStruct& subparser = m_subparsers[found];
+            SubparserEntry& entry = *subparser.entry;
+            std::call_once(entry.built, [&]()
             {
-                bool shortHelpAlreadyExists = false, longHelpAlreadyExists = false;
-                auto foundArgObject = m_knownArgumentNamesInternal.find(_pref + "h");
-                shortHelpAlreadyExists = foundArgObject != m_knownArgumentNamesInternal.end();
-                foundArgObject = m_knownArgumentNamesInternal.find(_doublePref + "help");
-                longHelpAlreadyExists = foundArgObject != m_knownArgumentNamesInternal.end();
-                if (!shortHelpAlreadyExists || !longHelpAlreadyExists)
-                {
-                    Argument arg = Argument::CreateNamedArgument(shortHelpAlreadyExists ? "" : "h", longHelpAlreadyExists ? "" : "help", 0);
-                    arg.SetHelp("Show help!");
-                    arg.SetRequired(false);
-                    _addArg(arg);
-                    if (!shortHelpAlreadyExists)
-                    {
-                        m_knownArgumentNamesInternal[_pref + arg.m_shortName] = { m_arguments.size()-1, KnownNameType::e_Short };
-                    }
-                    if (!longHelpAlreadyExists)
-                    {
-                        m_knownArgumentNamesInternal[_doublePref + arg.m_longName] = { m_arguments.size()-1, KnownNameType::e_Long };
-                    }
-                }
+                std::unique_ptr<ArgumentParser> parser(new ArgumentParser(m_name + " " + subparser.name));
+                subparser.factory(*parser);
+                parser->Freeze();
+                entry.parser = std::move(parser);
+            });
+
+            if (argObj.m_subcommandArgs.empty())
+            {
+                argObj.m_subcommandArgs.emplace_back(argObj.m_resource);
             }
+            ArgumentsObject& subcommandArgs = argObj.m_subcommandArgs.front();
+            entry.parser->_parseTokens(tokens, subcommandArgs);
+            if (!subcommandArgs.IsArgValid())
+            {
+                argObj.SetErrorString(subcommandArgs.GetErrorString());
+                return false;
+            }
+            argObj.m_subcommand = subparser.name;
+            dispatched = true;
+            return true;
+        }
 
-            if (m_allowAbbrev)
+        /// @brief Keeps positional token for distribution between positional arguments.
+        /// If the only positional argument is variadic and has sink, token is parsed at once.
+        /// @return false if token cannot be parsed, error is set to argObj
+        bool _pushPositional(ArgumentsObject& argObj, ValueVector<StringView>& positionalArgs, StringView token) const
+        {
+            if (m_streamedPositional == kSizeTypeEnd)
             {
-                AddShortNames();
+                positionalArgs.push_back(token);
+                return true;
             }
+            const Argument& argument = m_arguments[m_streamedPositional];
+            argObj.CreateParcingStub(argument, m_streamedPositional);
+            return argObj.Parse(argument, m_streamedPositional, token);
+        }
+
+        /// @brief Line of ParseBatch which is a whole command line string
+        bool _parseLine(ArgumentsObject& result, StringView line) const
+        {
+            return ParseCommandLineInto(result, line);
+        }
 
+        /// @brief Line of ParseBatch which is a range of tokens
+        template<typename Range>
+        typename std::enable_if<!std::is_convertible<const Range&, StringView>::value, bool>::type
+            _parseLine(ArgumentsObject& result, const Range& line) const
+        {
+            return ParseInto(result, std::begin(line), std::end(line));
+        }
+
+        /// @brief Parsing core shared by all ParseArgs overloads
+        /// @tparam TokenSource class with functions bool Next(StringView&), bool HasError()
+        /// and const std::string& GetError()
+        /// @param tokens source of input tokens. Views must be alive until parsing ends.
+        /// @param argObj result to fill. Its previous values are dropped, memory is reused.
+        template<typename TokenSource>
+        void _parseTokens(TokenSource& tokens, ArgumentsObject& argObj) const
+        {
+            if (!m_frozen)
+            {
+                throw std::runtime_error("parser is not frozen, call Freeze() before parsing with const parser");
+            }
 
+            ARGPARSE_STATS(detail::StatsScope statsScope(argObj.m_stats, m_buildNs);)
             bool positionalArgsEndFlag = false;
             size_t currentArgumentObjectIndex = kSizeTypeEnd;
-            std::vector<std::string> positionalArgs;
-            ArgumentsObject argObj;
-            for (size_t i =0; i < args.size(); ++i)
+            argObj.Init(m_arguments.size(), m_resultNames);
+            ValueVector<StringView>& positionalArgs = argObj.m_positionalTokens;
+            ARGPARSE_STATS(uint64_t phaseStart = detail::nowNs();)
+            StringView el;
+            for (size_t i = 0; tokens.Next(el); ++i)
             {
-                const std::string& el = args[i];
-                const auto foundArgObject = m_knownArgumentNamesInternal.find(el);
-                if (foundArgObject != m_knownArgumentNamesInternal.end())
+                ARGPARSE_STATS(++argObj.m_stats.tokens;)
+                size_t foundPosition = m_namesIndex.Find(el);
+                if (foundPosition == detail::PerfectHashIndex::kNotFound && m_abbrevIndex.Size() != 0)
+                {
+                    if (!_abbreviationHit(argObj, i+1, el, foundPosition))
+                    {
+                        return;
+                    }
+                }
+                if (foundPosition != detail::PerfectHashIndex::kNotFound)
                 {
-                    currentArgumentObjectIndex = foundArgObject->second.position;
+                    currentArgumentObjectIndex = foundPosition;
 
-                    Argument& argument = m_arguments[currentArgumentObjectIndex];
+                    const Argument& argument = m_arguments[currentArgumentObjectIndex];
                     if (argument.m_nargs == 0)
                     {
                         if (!argObj.Parse(argument, currentArgumentObjectIndex, el))
                         {
-                            return argObj;
+                            return;
                         }
                     }
                     else
@@ -1340,51 +5184,84 @@ namespace ARGPARSE_NAMESPACE_NAME
                     positionalArgsEndFlag = true;
                     continue;
                 }
-                else if (!positionalArgsEndFlag)
+                else if (!m_subparsers.empty() && (el.empty() || el[0] != m_prefix || isNumber(el)))
+                {
+                    bool dispatched = false;
+                    if (!_subcommandHit(tokens, argObj, currentArgumentObjectIndex, el, dispatched))
+                    {
+                        return;
+                    }
+                    if (dispatched)
+                    {
+                        break;
+                    }
+                }
+
+                if (!positionalArgsEndFlag)
                 {
                     if (isNumber(el))
                     {
-                        positionalArgs.push_back(el);
+                        if (!_pushPositional(argObj, positionalArgs, el))
+                        {
+                            return;
+                        }
                     }
-                    else if (el.find(_pref) == 0 || el.find(_doublePref) == 0)
+                    else if (!el.empty() && el[0] == m_prefix)
                     {
                         if (!_uknownArgumentHit(argObj, i+1, currentArgumentObjectIndex, positionalArgsEndFlag, el))
                         {
-                            return argObj;
+                            return;
                         }
                     }
                     else
                     {
-                        positionalArgs.push_back(el);
+                        if (!_pushPositional(argObj, positionalArgs, el))
+                        {
+                            return;
+                        }
                     }
                     continue;
                 }
-                else if (el.find(_pref) == 0 || el.find(_doublePref) == 0)
+                else if (!el.empty() && el[0] == m_prefix)
                 {
                     if (!_uknownArgumentHit(argObj, i+1, currentArgumentObjectIndex, positionalArgsEndFlag, el))
                     {
-                        return argObj;
+                        return;
                     }
                     continue;
                 }
 
                 if (currentArgumentObjectIndex != kSizeTypeEnd)
                 {
-                    Argument& argument = m_arguments[currentArgumentObjectIndex];
+                    const Argument& argument = m_arguments[currentArgumentObjectIndex];
 
                     if (!argObj.Parse(argument, currentArgumentObjectIndex, el))
                     {
-                        return argObj;
+                        return;
                     }
                 }
             }
 
+            ARGPARSE_STATS(argObj.m_stats.scanNs = detail::nowNs() - phaseStart;)
+            if (tokens.HasError())
+            {
+                argObj.SetErrorString(tokens.GetError());
+                return;
+            }
+
+            if (m_subparsersRequired && !m_subparsers.empty() && argObj.m_subcommand.empty())
+            {
+                argObj.SetErrorString("Subcommand is required");
+                return;
+            }
+
+            ARGPARSE_STATS(argObj.m_stats.positionalTokens = positionalArgs.size(); phaseStart = detail::nowNs();)
             if (!positionalArgs.empty())
             {
                 if (m_positionalArgumentNames.empty())
                 {
-                    argObj.SetErrorString("Unknown positional argument:" + positionalArgs.front());
-                    return argObj;
+                    argObj.SetErrorString("Unknown positional argument:" + std::string(positionalArgs.front()));
+                    return;
                 }
                 size_t minimumRequiredPositinalCount = 0;
                 size_t infiniteRequiredPositionalCount = 0;
@@ -1405,7 +5282,7 @@ namespace ARGPARSE_NAMESPACE_NAME
                 if (minimumRequiredPositinalCount > positionalArgs.size())
                 {
                     argObj.SetErrorString("Too few positional arguments: required " + std::to_string(positionalArgs.size()) + " got " + std::to_string(minimumRequiredPositinalCount));
-                    return argObj;
+                    return;
                 }
 
                 size_t totalTokensForRequiredNargs = 1;
@@ -1416,7 +5293,7 @@ namespace ARGPARSE_NAMESPACE_NAME
                     if (infiniteRequiredPositionalCount == 0)
                     {
                         argObj.SetErrorString("Too many positional arguments!");
-                        return argObj;
+                        return;
                     }
                     else
                     {
@@ -1432,7 +5309,7 @@ namespace ARGPARSE_NAMESPACE_NAME
 
                 for (auto& el : m_positionalArgumentNames)
                 {
-                    Argument& argument = m_arguments[el.positionInArguments];
+                    const Argument& argument = m_arguments[el.positionInArguments];
                     argObj.CreateParcingStub(argument, el.positionInArguments);
 
                     if (m_arguments[el.positionInArguments].m_required)
@@ -1444,7 +5321,7 @@ namespace ARGPARSE_NAMESPACE_NAME
                             {
                                 if (!argObj.Parse(argument, el.positionInArguments, positionalArgs[currentTokenPosition]))
                                 {
-                                    return argObj;
+                                    return;
                                 }
                                 ++currentTokenPosition;
                             }
@@ -1461,7 +5338,7 @@ namespace ARGPARSE_NAMESPACE_NAME
                             {
                                 if (!argObj.Parse(argument, el.positionInArguments, positionalArgs[currentTokenPosition]))
                                 {
-                                    return argObj;
+                                    return;
                                 }
                                 ++currentTokenPosition;
                             }
@@ -1471,7 +5348,7 @@ namespace ARGPARSE_NAMESPACE_NAME
                     {
                         if (!argObj.Parse(argument, el.positionInArguments, positionalArgs[currentTokenPosition]))
                         {
-                            return argObj;
+                            return;
                         }
                         ++currentTokenPosition;
                         ++optionalParsed;
@@ -1479,12 +5356,23 @@ namespace ARGPARSE_NAMESPACE_NAME
                 }
             }
 
+            ARGPARSE_STATS(argObj.m_stats.positionalNs = detail::nowNs() - phaseStart; phaseStart = detail::nowNs();)
+            // fallbacks go after positional arguments, so they fill only what command line doesn't give
+            if (m_envIndex.Size() != 0 && !_mergeEnvironment(argObj))
+            {
+                return;
+            }
+            if (m_config && !_mergeConfig(argObj))
+            {
+                return;
+            }
+            ARGPARSE_STATS(argObj.m_stats.fallbackNs = detail::nowNs() - phaseStart; phaseStart = detail::nowNs();)
             for (size_t i = 0; i < m_arguments.size(); ++i)
             {
-                auto el = m_arguments[i];
+                const Argument& el = m_arguments[i];
                 const std::string& name = el.m_longName.empty() ? (el.m_shortName.empty() ? el.m_positionalName : el.m_shortName) : el.m_longName;
 
-                ArgumentParsed parsedArg = argObj.GetArg(name);
+                const ArgumentParsed& parsedArg = argObj.m_parsed[i];
 
                 if (parsedArg.GetArgumentExists())
                 {
@@ -1497,7 +5385,7 @@ namespace ARGPARSE_NAMESPACE_NAME
                     else
                     {
                         argObj.SetErrorString("Wrong arguments count for argument with name \"" + name + "\" got = " + std::to_string(parsedArg.GetArgumentCount()));
-                        return argObj;
+                        return;
                     }
                 }
                 else if (el.HasDefault())
@@ -1507,22 +5395,29 @@ namespace ARGPARSE_NAMESPACE_NAME
                 else if (el.m_required)
                 {
                     argObj.SetErrorString("Required argument with name \"" + name + "\" doesn't exists");
-                    return argObj;
+                    return;
+                }
+                else if (el.IsBound())
+                {
+                    argObj.ResetBound(el);
                 }
             }
+            ARGPARSE_STATS(argObj.m_stats.validationNs = detail::nowNs() - phaseStart;)
 
             argObj.SetValid();
-            return argObj;
+
         }
 
-        /// @brief function which resolves unknown arguments presence
+    public:
+        /// @brief function which resolves unknown arguments presence,
+        /// error message suggests closest known names if there are any
         /// @param argObj
         /// @param positionInInput
         /// @param currentArgumentObjectIndex 
         /// @param positionalArgsEndFlag 
         /// @param el 
         /// @return bool - true for ignoring, false for stopping parse 
-        bool _uknownArgumentHit(ArgumentsObject& argObj, const size_t positionInInput, size_t& currentArgumentObjectIndex, bool& positionalArgsEndFlag, const std::string& el)
+        bool _uknownArgumentHit(ArgumentsObject& argObj, const size_t positionInInput, size_t& currentArgumentObjectIndex, bool& positionalArgsEndFlag, StringView el) const
         {
             if (m_ignoreUknownArgs)
             {
@@ -1532,122 +5427,355 @@ namespace ARGPARSE_NAMESPACE_NAME
             }
             std::stringstream ss;
             ss << "Unknown input argument: \"" << el << "\" at position " << positionInInput;
+
+            // allowed distance grows with length of name, short tokens are too close to everything
+            size_t nameSize = el.size();
+            for (size_t i = 0; i < el.size() && i < 2 && el[i] == m_prefix; ++i)
+            {
+                --nameSize;
+            }
+            const std::vector<StringView> suggestions = m_suggestions.Suggest(el, std::min<size_t>(3, nameSize / 3), 3);
+            for (size_t i = 0; i < suggestions.size(); ++i)
+            {
+                ss << (i == 0 ? ". Did you mean " : ", ") << suggestions[i];
+            }
+            if (!suggestions.empty())
+            {
+                ss << "?";
+            }
             argObj.SetErrorString(ss.str());
             return false;
         }
 
-        /// @brief This function just converts argc and argv to vector of token
-        /// @param argc count of arguments
-        /// @param argv pointer to array of char*
-        /// @return ArgumentsObject, which contains valid ArgumentParsed if parsing successful or
-        /// information about errors if not
-        ArgumentsObject ParseArgs(const int argc, char** argv)
+        /// @brief Function to get help string
+        /// @param width current terminal width (80 by default)
+        /// @param nameWidthPercent percentage of current width, for naming parameters (30 by default)
+        /// @return help string with proper new lines
+        std::string GetHelp(size_t width = kHelpWidth, size_t nameWidthPercent = kHelpNameWidthPercent)
+        {
+            width = width < kHelpWidth ? kHelpWidth : width;
+            size_t nameWidthInHelp = kHelpNameWidthPercent * width / 100;
+            width -= nameWidthInHelp;
+
+
+            std::stringstream usage("usage: ");
+            usage << m_name << " ";
+            if (m_positionalArgumentNames.size())
+            {
+                for (auto& el : m_positionalArgumentNames)
+                {
+                    Argument& arg = m_arguments[el.positionInArguments];
+                    MakeUsageForName(arg, usage);
+                }
+            }
+            for (auto& el : m_arguments)
+            {
+                if (el.m_positionalName.empty())
+                {
+                    MakeUsageForName(el, usage);
+                }
+            }
+
+            if (!m_description.empty())
+            {
+                AddAdditionalDescription(usage, m_description, width+nameWidthInHelp);
+            }
+
+            if (m_positionalArgumentNames.size())
+            {
+                usage << "\n\n" << "positional arguments:\n\n";
+                for (auto& el : m_positionalArgumentNames)
+                {
+                    Argument& arg = m_arguments[el.positionInArguments];
+                    MakeDescriptionForArg(arg, usage, nameWidthInHelp, width);
+                }
+            }
+
+            if (m_arguments.size() > m_positionalArgumentNames.size())
+            {
+                usage << "\n\n" << "named arguments:\n\n";
+                for (auto& el : m_arguments)
+                {
+                    if (el.m_positionalName.empty())
+                    {
+                        MakeDescriptionForArg(el, usage, nameWidthInHelp, width);
+                    }
+                }
+            }
+
+            if (!m_subparsers.empty())
+            {
+                usage << "\n\n" << m_subparsersTitle << ":\n\n";
+                for (auto& el : m_subparsers)
+                {
+                    MakeDescriptionForArg(Argument::CreatePositionalArgument(el.name, 0, ArgTypeCast::e_String, m_subparsersRequired, el.help), usage, nameWidthInHelp, width);
+                }
+            }
+
+            if (!m_epilogue.empty())
+            {
+                AddAdditionalDescription(usage, m_epilogue, width+nameWidthInHelp);
+            }
+
+            return usage.str();
+        }
+
+    private:
+        /// @brief Private function which is generate short names
+        /// if m_allowAbbrev is true. Argument with long name only gets first letter
+        /// of it as short name if no other short or long name starts with this letter.
+        /// Positions are kept in m_generatedShortNames, so _invalidate can remove the names.
+        void AddShortNames()
+        {
+            std::string _pref{ m_prefix };
+            std::string _doublePref{ m_prefix, m_prefix };
+
+            // count of names per first letter, so every argument is checked in constant time
+            size_t namesPerLetter[256] = {};
+            for (auto& el : m_knownArgumentNamesInternal)
+            {
+                const size_t prefixSize = el.first.compare(0, 2, _doublePref) == 0 ? 2 : 1;
+                if (el.first.size() > prefixSize)
+                {
+                    ++namesPerLetter[static_cast<unsigned char>(el.first[prefixSize])];
+                }
+            }
+
+            for (size_t position = 0; position < m_arguments.size(); ++position)
+            {
+                Argument& el1 = m_arguments[position];
+                if (el1.m_longName.empty() || !el1.m_positionalName.empty() || !el1.m_shortName.empty())
+                {
+                    continue;
+                }
+
+                if (namesPerLetter[static_cast<unsigned char>(el1.m_longName[0])] == 1)
+                {
+                    el1.m_shortName = el1.m_longName.substr(0, 1);
+                    m_knownArgumentNamesInternal[_pref + el1.m_shortName] = { position, KnownNameType::e_Short };
+                    m_generatedShortNames.push_back(position);
+                }
+            }
+        }
+
+        /// @brief Private function which fills arguments absent in command line with values from configuration files
+        /// @param argObj result of parsing
+        /// @return false if value of configuration file cannot be parsed, error is set to argObj
+        bool _mergeConfig(ArgumentsObject& argObj) const
+        {
+            const ConfigValuesStruct& config = *m_config;
+            if (!config.error.empty())
+            {
+                argObj.SetErrorString(config.error);
+                return false;
+            }
+            for (size_t i = 0; i < config.values.size(); ++i)
+            {
+                if (config.values[i].empty() || argObj.m_parsed[i].GetArgumentExists())
+                {
+                    continue;
+                }
+                detail::RangeTokens<std::vector<StringView>::const_iterator> values(config.values[i].begin(), config.values[i].end());
+                if (!_parseFallback(argObj, i, values))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// @brief Private function which fills arguments absent in command line with values
+        /// of environment variables. Environment is walked once, names are matched by m_envIndex.
+        /// @param argObj result of parsing
+        /// @return false if value of variable cannot be parsed, error is set to argObj
+        bool _mergeEnvironment(ArgumentsObject& argObj) const
+        {
+            for (char** variable = detail::environment(); variable != nullptr && *variable != nullptr; ++variable)
+            {
+                const char* entry = *variable;
+                const char* equal = std::strchr(entry, '=');
+                if (equal == nullptr || equal == entry)
+                {
+                    continue;
+                }
+                const size_t position = m_envIndex.Find(StringView(entry, static_cast<size_t>(equal - entry)));
+                if (position == detail::PerfectHashIndex::kNotFound || argObj.m_parsed[position].GetArgumentExists())
+                {
+                    continue;
+                }
+                const StringView value(equal + 1, std::strlen(equal + 1));
+                if (value.empty())
+                {
+                    continue;
+                }
+                if (m_arguments[position].m_nargs == 1)
+                {
+                    detail::RangeTokens<const StringView*> values(&value, &value + 1);
+                    if (!_parseFallback(argObj, position, values))
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    detail::CommandLineTokens values(value);
+                    if (!_parseFallback(argObj, position, values))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        /// @brief Private function which parses values of argument absent in command line
+        /// taken from environment or configuration files. Flags accept true or false.
+        /// @param argObj result of parsing
+        /// @param position index of argument in m_arguments
+        /// @param values source of value tokens
+        /// @return false if value cannot be parsed, error is set to argObj
+        template<typename TokenSource>
+        bool _parseFallback(ArgumentsObject& argObj, const size_t position, TokenSource& values) const
         {
-
-            std::vector<std::string> args;
-            for (int i = 1; i < argc; ++i)
+            const Argument& argument = m_arguments[position];
+            StringView value;
+            if (argument.m_nargs == 0)
             {
-                args.emplace_back(argv[i]);
+                if (!values.Next(value) || value == "False" || value == "FALSE" || value == "false")
+                {
+                    return true;
+                }
+                if (!(value == "True" || value == "TRUE" || value == "true"))
+                {
+                    return argObj.InvalidateArgsCannotParse(argument, value);
+                }
+                return argObj.Parse(argument, position, value);
             }
-
-            return ParseArgs(args);
+            argObj.CreateParcingStub(argument, position);
+            while (values.Next(value))
+            {
+                if (!argObj.Parse(argument, position, value))
+                {
+                    return false;
+                }
+            }
+            if (values.HasError())
+            {
+                argObj.SetErrorString(values.GetError());
+                return false;
+            }
+            return true;
         }
 
-        /// @brief Function to get help string
-        /// @param width current terminal width (80 by default)
-        /// @param nameWidthPercent percentage of current width, for naming parameters (30 by default)
-        /// @return help string with proper new lines
-        std::string GetHelp(size_t width = kHelpWidth, size_t nameWidthPercent = kHelpNameWidthPercent)
+        /// @brief Private function which builds m_envIndex from Argument::SetEnv names
+        /// and names generated by SetEnvPrefix
+        void _buildEnvIndex()
         {
-            width = width < kHelpWidth ? kHelpWidth : width;
-            size_t nameWidthInHelp = kHelpNameWidthPercent * width / 100;
-            width -= nameWidthInHelp;
-
-
-            std::stringstream usage("usage: ");
-            usage << m_name << " ";
-            if (m_positionalArgumentNames.size())
+            std::map<std::string, size_t> envNames;
+            for (size_t i = 0; i < m_arguments.size(); ++i)
             {
-                for (auto& el : m_positionalArgumentNames)
+                const Argument& arg = m_arguments[i];
+                if (!arg.m_env.empty())
                 {
-                    Argument& arg = m_arguments[el.positionInArguments];
-                    MakeUsageForName(arg, usage);
+                    envNames.insert({ arg.m_env, i });
                 }
-            }
-            for (auto& el : m_arguments)
-            {
-                if (el.m_positionalName.empty())
+                else if (!m_envPrefix.empty() && !arg.m_longName.empty())
                 {
-                    MakeUsageForName(el, usage);
+                    std::string name = m_envPrefix;
+                    for (char sym : arg.m_longName)
+                    {
+                        name.push_back(sym == '-' ? '_' : static_cast<char>(std::toupper(static_cast<unsigned char>(sym))));
+                    }
+                    envNames.insert({ name, i });
                 }
             }
+            m_envIndex.Build(std::vector<std::pair<std::string, size_t>>(envNames.begin(), envNames.end()));
+        }
 
-            if (!m_description.empty())
+        /// @brief Private function which reads configuration files into m_config
+        /// on Freeze. Only long names are looked up. Files are released at the end,
+        /// values of found keys are copied, so files can change while parser is alive.
+        void _loadConfigFiles()
+        {
+            m_config.reset();
+            if (m_configFiles.empty())
             {
-                AddAdditionalDescription(usage, m_description, width+nameWidthInHelp);
+                return;
             }
 
-            if (m_positionalArgumentNames.size())
+            std::vector<std::pair<std::string, size_t>> names;
+            for (size_t i = 0; i < m_arguments.size(); ++i)
             {
-                usage << "\n\n" << "positional arguments:\n\n";
-                for (auto& el : m_positionalArgumentNames)
+                if (!m_arguments[i].m_longName.empty())
                 {
-                    Argument& arg = m_arguments[el.positionInArguments];
-                    MakeDescriptionForArg(arg, usage, nameWidthInHelp, width);
+                    names.emplace_back(m_arguments[i].m_longName, i);
                 }
             }
-
-            if (m_arguments.size() > m_positionalArgumentNames.size())
+            detail::PerfectHashIndex index;
+            index.Build(names);
+
+            std::shared_ptr<ConfigValuesStruct> config = std::make_shared<ConfigValuesStruct>();
+            m_config = config;
+            config->values.resize(m_arguments.size());
+            // views point into files and unescaped strings until values are copied below
+            std::vector<std::unique_ptr<detail::FileContents>> files;
+            std::deque<std::string> unescaped;
+            detail::ConfigReader reader(index, config->values, unescaped);
+            for (const ConfigFileStruct& file : m_configFiles)
             {
-                usage << "\n\n" << "named arguments:\n\n";
-                for (auto& el : m_arguments)
+                files.emplace_back(new detail::FileContents());
+                detail::FileContents& contents = *files.back();
+                if (!contents.Open(file.path))
                 {
-                    if (el.m_positionalName.empty())
-                    {
-                        MakeDescriptionForArg(el, usage, nameWidthInHelp, width);
-                    }
+                    continue;
+                }
+                const StringView text(contents.Data(), contents.Size());
+                const StringView section(file.section.data(), file.section.size());
+                const bool success = file.format == ConfigFormat::e_Json ? reader.ReadJson(text, section) : reader.ReadIni(text, section);
+                if (!success)
+                {
+                    config->error = "Error in config file \"" + file.path + "\" " + reader.GetError();
+                    config->values.clear();
+                    return;
                 }
             }
 
-            if (!m_epilogue.empty())
+            for (std::vector<StringView>& values : config->values)
             {
-                AddAdditionalDescription(usage, m_epilogue, width+nameWidthInHelp);
+                for (StringView& value : values)
+                {
+                    config->strings.emplace_back(value.data(), value.size());
+                    value = StringView(config->strings.back().data(), config->strings.back().size());
+                }
             }
-
-            return usage.str();
         }
 
-    private:
-
-
-        /// @brief Private function which is generate short names
-        /// if m_allowAbbrev is true
-        void AddShortNames()
+        /// @brief Private function which drops compiled state created by Freeze.
+        /// Generated short names and help argument are removed too, so they are
+        /// created again according to current settings and arguments.
+        void _invalidate() noexcept
         {
-            std::string _pref{ m_prefix };
-
-            for (auto& el1 : m_arguments)
+            for (size_t position : m_generatedShortNames)
             {
-                if (!el1.m_longName.empty() && (!el1.m_positionalName.empty() || !el1.m_shortName.empty()))
-                {
-                    continue;
-                }
-                int count = 0;
+                m_arguments[position].m_shortName.clear();
+            }
+            m_generatedShortNames.clear();
 
-                std::string firstLetter = el1.m_longName.substr(0, 1);
-                for (auto& el : m_knownArgumentNames)
+            // help is added last by Freeze and arguments can't be added without invalidation
+            if (m_helpPosition != kSizeTypeEnd)
+            {
+                const Argument& help = m_arguments[m_helpPosition];
+                for (const std::string* name : { &help.m_shortName, &help.m_longName })
                 {
-                    if (el.first.find(firstLetter) != 0)
+                    if (!name->empty())
                     {
-                        ++count;
+                        m_knownArgumentNames.erase(*name);
                     }
                 }
-                if (count == 1)
-                {
-                    el1.m_shortName = firstLetter;
-                    m_knownArgumentNamesInternal[_pref + firstLetter] = { m_knownArgumentNames[el1.m_longName].position, KnownNameType::e_Short };
-                }
+                m_arguments.pop_back();
+                m_helpPosition = kSizeTypeEnd;
             }
+            m_frozen = false;
         }
 
         /// @brief Private function which is called in case if AddArgument function
@@ -1705,31 +5833,31 @@ namespace ARGPARSE_NAMESPACE_NAME
         /// @brief Private function which generates usage according to all argument of program
         /// @param arg Argument instance
         /// @param usage out parameter, which returns usage.
-        void MakeUsageForName(Argument& arg, std::stringstream& usage)
+        void MakeUsageForName(const Argument& arg, std::stringstream& usage)
         {
             if (!arg.m_required)
             {
                 usage << "[";
             }
             std::stringstream showName;
-            if (arg.m_choicesDouble.size() + arg.m_choicesInt.size() + arg.m_choicesLongLong.size() + arg.m_choicesString.size())
+            if (arg.HasChoices())
             {
                 showName << "{";
                 if (arg.m_type == ArgTypeCast::e_String)
                 {
-                    MakeChoicesToString<std::string>(showName, arg.m_choicesString);
+                    MakeChoicesToString(showName, arg.m_choicesString);
                 }
                 else if (arg.m_type == ArgTypeCast::e_int)
                 {
-                    MakeChoicesToString<int>(showName, arg.m_choicesInt);
+                    MakeChoicesToString(showName, arg.m_choicesInt);
                 }
                 else if (arg.m_type == ArgTypeCast::e_double)
                 {
-                    MakeChoicesToString<double>(showName, arg.m_choicesDouble);
+                    MakeChoicesToString(showName, arg.m_choicesDouble);
                 }
                 else if (arg.m_type == ArgTypeCast::e_longlong)
                 {
-                    MakeChoicesToString<long long>(showName, arg.m_choicesLongLong);
+                    MakeChoicesToString(showName, arg.m_choicesLongLong);
                 }
                 showName << "}";
             }
@@ -1797,30 +5925,30 @@ namespace ARGPARSE_NAMESPACE_NAME
         /// @param nameLen actual length of names column in usage. If names are longer then nameLen new line will be added before first line of description/
         /// nameLen is calculated according to terminal width and name nameWidthPercent from GetHelp input parameters
         /// @param descLen length of description column of usage.
-        void MakeDescriptionForArg(Argument& arg, std::stringstream& description, size_t nameLen, size_t descLen)
+        void MakeDescriptionForArg(const Argument& arg, std::stringstream& description, size_t nameLen, size_t descLen)
         {
             std::stringstream showName;
             std::stringstream showDesc;
             if (!arg.m_positionalName.empty())
             {
-                if (arg.m_choicesDouble.size() + arg.m_choicesInt.size() + arg.m_choicesLongLong.size() + arg.m_choicesString.size())
+                if (arg.HasChoices())
                 {
                     showName << "{";
                     if (arg.m_type == ArgTypeCast::e_String)
                     {
-                        MakeChoicesToString<std::string>(showName, arg.m_choicesString);
+                        MakeChoicesToString(showName, arg.m_choicesString);
                     }
                     else if (arg.m_type == ArgTypeCast::e_int)
                     {
-                        MakeChoicesToString<int>(showName, arg.m_choicesInt);
+                        MakeChoicesToString(showName, arg.m_choicesInt);
                     }
                     else if (arg.m_type == ArgTypeCast::e_double)
                     {
-                        MakeChoicesToString<double>(showName, arg.m_choicesDouble);
+                        MakeChoicesToString(showName, arg.m_choicesDouble);
                     }
                     else if (arg.m_type == ArgTypeCast::e_longlong)
                     {
-                        MakeChoicesToString<long long>(showName, arg.m_choicesLongLong);
+                        MakeChoicesToString(showName, arg.m_choicesLongLong);
                     }
                     showName << "}";
                 }
@@ -1849,24 +5977,24 @@ namespace ARGPARSE_NAMESPACE_NAME
             }
 
             if ((!arg.m_shortName.empty() || !arg.m_longName.empty())
-                && (arg.m_choicesDouble.size() + arg.m_choicesInt.size() + arg.m_choicesLongLong.size() + arg.m_choicesString.size()))
+                && arg.HasChoices())
             {
                 showDesc << " Choices:";
                 if (arg.m_type == ArgTypeCast::e_String)
                 {
-                    MakeChoicesToString<std::string>(showDesc, arg.m_choicesString);
+                    MakeChoicesToString(showDesc, arg.m_choicesString);
                 }
                 else if (arg.m_type == ArgTypeCast::e_int)
                 {
-                    MakeChoicesToString<int>(showDesc, arg.m_choicesInt);
+                    MakeChoicesToString(showDesc, arg.m_choicesInt);
                 }
                 else if (arg.m_type == ArgTypeCast::e_double)
                 {
-                    MakeChoicesToString<double>(showDesc, arg.m_choicesDouble);
+                    MakeChoicesToString(showDesc, arg.m_choicesDouble);
                 }
                 else if (arg.m_type == ArgTypeCast::e_longlong)
                 {
-                    MakeChoicesToString<long long>(showDesc, arg.m_choicesLongLong);
+                    MakeChoicesToString(showDesc, arg.m_choicesLongLong);
                 }
                 showDesc << ". ";
             }
@@ -1949,11 +6077,11 @@ namespace ARGPARSE_NAMESPACE_NAME
 
         /// @brief Private function which generates choices for Argument instance description, if argument has
         /// any choices
-        /// @tparam T type of choices vector
+        /// @tparam Container type of choices vector
         /// @param outSstream output string stream
         /// @param choices vector of available choices.
-        template<typename T>
-        void MakeChoicesToString(std::stringstream& outSstream, std::vector<T>& choices)
+        template<typename Container>
+        void MakeChoicesToString(std::stringstream& outSstream, const Container& choices)
         {
             outSstream << choices.front();
             for (size_t i = 1; i < choices.size(); ++i)
@@ -1974,6 +6102,39 @@ namespace ARGPARSE_NAMESPACE_NAME
             KnownNameType argNameType;
         };
 
+        /// @brief Parser of subcommand, built once on first use
+        struct SubparserEntry
+        {
+            std::once_flag built;
+            std::unique_ptr<ArgumentParser> parser;
+        };
+
+        struct SubparserStruct
+        {
+            std::string name;
+            std::string help;
+            std::function<void(ArgumentParser&)> factory;
+            /// @brief shared by copies of parser, so subcommand is built once
+            std::shared_ptr<SubparserEntry> entry;
+        };
+
+        struct ConfigFileStruct
+        {
+            std::string  path;
+            ConfigFormat format;
+            std::string  section;
+        };
+
+        struct ConfigValuesStruct
+        {
+            /// @brief copies of values, deque keeps views into them valid
+            std::deque<std::string> strings;
+            /// @brief values per argument index
+            std::vector<std::vector<StringView>> values;
+            /// @brief syntax error of configuration files, reported by every parse
+            std::string error;
+        };
+
         struct PositionalNamesStruct
         {
             PositionalNamesStruct(const size_t position, const std::string& name)
@@ -1985,7 +6146,8 @@ namespace ARGPARSE_NAMESPACE_NAME
         };
 
     private:
-        /// @brief allow generate short names for named arguments, short name not preset
+        /// @brief allow generate short names for named arguments, short name not preset,
+        /// and abbreviated long names
         bool        m_allowAbbrev = true;
         /// @brief generate help automatically
         bool        m_addHelp = true;
@@ -1993,6 +6155,16 @@ namespace ARGPARSE_NAMESPACE_NAME
         bool        m_ignoreUknownArgs = false;
         /// @brief prefix for short for named arguments
         char        m_prefix = '-';
+        /// @brief prefix of file with arguments, '\0' if reading from files is disabled
+        char        m_fromFilePrefix = '\0';
+        /// @brief names table, help and short names are compiled
+        bool        m_frozen = false;
+        /// @brief index of help argument added by Freeze, kSizeTypeEnd if it is not added
+        size_t      m_helpPosition = kSizeTypeEnd;
+        /// @brief arguments which got short name from Freeze, it is removed on invalidation
+        std::vector<size_t> m_generatedShortNames;
+        /// @brief convert numeric values on first access, see SetLazyConversion
+        bool        m_lazyConversion = false;
 
         /// @brief name of program which would be occur in command line
         /// if auto generated help is required
@@ -2013,8 +6185,38 @@ namespace ARGPARSE_NAMESPACE_NAME
         /// @brief map with arguments which added explicitly
         std::map<std::string, KnownNamesStruct> m_knownArgumentNames;
         /// @brief generated map with arguments after add short names if needed and so on
-        /// actual map which will be used for parsing
         std::map<std::string, KnownNamesStruct> m_knownArgumentNamesInternal;
+        /// @brief perfect hash over m_knownArgumentNamesInternal,
+        /// actual index which will be used for parsing
+        detail::PerfectHashIndex m_namesIndex;
+        /// @brief sorted prefixed long names for abbreviated options, empty if m_allowAbbrev is false
+        detail::PrefixIndex m_abbrevIndex;
+        /// @brief all prefixed names for suggestions in error about unknown argument
+        detail::SuggestionIndex m_suggestions;
+        /// @brief all names of arguments without prefixes to their index,
+        /// shared with ArgumentsObject instances for GetArg
+        std::shared_ptr<const std::map<std::string, size_t>> m_resultNames;
+        /// @brief subcommands added by AddSubparser
+        std::vector<SubparserStruct> m_subparsers;
+        /// @brief perfect hash of subcommand names to index in m_subparsers, compiled on Freeze
+        detail::PerfectHashIndex m_subparsersIndex;
+        std::string m_subparsersTitle{ "subcommands" };
+        bool        m_subparsersRequired = true;
+        /// @brief index of variadic positional argument with sink which is parsed without buffering,
+        /// kSizeTypeEnd if there is no such argument
+        size_t m_streamedPositional = kSizeTypeEnd;
+        /// @brief prefix of environment variables set by SetEnvPrefix
+        std::string m_envPrefix;
+        /// @brief perfect hash of environment variable names to argument index, compiled on Freeze
+        detail::PerfectHashIndex m_envIndex;
+#ifdef ARGPARSE_ENABLE_STATS
+        /// @brief time of last Freeze, reported in ParseStats::buildNs
+        uint64_t m_buildNs = 0;
+#endif
+        /// @brief configuration files added by AddConfigFile
+        std::vector<ConfigFileStruct> m_configFiles;
+        /// @brief values read from configuration files on Freeze, shared by copies of parser
+        std::shared_ptr<const ConfigValuesStruct> m_config;
 
         std::map<const ArgTypeCast, const std::string> m_enumToString
         {
@@ -2025,4 +6227,352 @@ namespace ARGPARSE_NAMESPACE_NAME
             {ArgTypeCast::e_bool,       "BOOL"}
         };
     };
-}
\ No newline at end of file
+
+#ifdef ARGPARSE_HAS_CXX20
+    /// @brief String literal which can be passed as template argument, used by Option
+    template<size_t N>
+    struct FixedString
+    {
+        constexpr FixedString(const char (&str)[N])
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                m_data[i] = str[i];
+            }
+        }
+
+        constexpr size_t Size() const noexcept
+        {
+            return N - 1;
+        }
+
+        char m_data[N] = {};
+    };
+
+    namespace detail
+    {
+        template<typename T>
+        struct MemberPointerTraits;
+
+        template<typename Struct, typename T>
+        struct MemberPointerTraits<T Struct::*>
+        {
+            using StructType = Struct;
+            using ValueType = T;
+        };
+
+        template<typename T>
+        struct IsVector : std::false_type
+        {};
+
+        template<typename T, typename Allocator>
+        struct IsVector<std::vector<T, Allocator>> : std::true_type
+        {};
+
+        template<typename T>
+        struct ElementOf
+        {
+            using Type = T;
+        };
+
+        template<typename T, typename Allocator>
+        struct ElementOf<std::vector<T, Allocator>>
+        {
+            using Type = T;
+        };
+
+        /// @brief Conversion of token to value of member type, chosen at compile time
+        /// @return false if token cannot be converted
+        template<typename T>
+        bool convertToken(StringView token, T& value)
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                value.assign(token.data(), token.size());
+                return true;
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                if (token == "True" || token == "TRUE" || token == "true")
+                {
+                    value = true;
+                    return true;
+                }
+                if (token == "False" || token == "FALSE" || token == "false")
+                {
+                    value = false;
+                    return true;
+                }
+                return false;
+            }
+            else if constexpr (std::is_same_v<T, int> || std::is_same_v<T, long long>)
+            {
+                return parseInteger(token, value) == ConversionResult::e_Ok;
+            }
+            else
+            {
+                static_assert(std::is_same_v<T, double>, "supported member types: bool, int, long long, double, std::string and std::vector of them");
+                return isNumber(token) && parseDouble(token, value) == ConversionResult::e_Ok;
+            }
+        }
+    }
+
+    /// @brief Compile time description of one option of Schema.
+    /// Type of member defines behavior: bool is a flag without value, std::vector<T> takes
+    /// all following values until next option, other types take exactly one value.
+    /// @tparam Member pointer to data member, e.g. &Options::threads
+    /// @tparam LongName long name without prefix, e.g. "threads" for "--threads"
+    /// @tparam ShortName optional short name without prefix, e.g. 't' for "-t"
+    /// @tparam Required parsing fails if option is absent in input
+    template<auto Member, FixedString LongName, char ShortName = '\0', bool Required = false>
+    struct Option
+    {
+        using StructType = typename detail::MemberPointerTraits<decltype(Member)>::StructType;
+        using ValueType = typename detail::MemberPointerTraits<decltype(Member)>::ValueType;
+
+        static constexpr auto kMember = Member;
+        static constexpr bool kIsFlag = std::is_same_v<ValueType, bool>;
+        static constexpr bool kIsList = detail::IsVector<ValueType>::value;
+        static constexpr bool kRequired = Required;
+
+        /// @brief Checks token against "--long" and "-s" forms of option name
+        static constexpr bool Matches(StringView token) noexcept
+        {
+            if (token.size() == LongName.Size() + 2 && token[0] == '-' && token[1] == '-')
+            {
+                for (size_t i = 0; i < LongName.Size(); ++i)
+                {
+                    if (token[i + 2] != LongName.m_data[i])
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            return ShortName != '\0' && token.size() == 2 && token[0] == '-' && token[1] == ShortName;
+        }
+
+        static std::string Name()
+        {
+            return std::string(LongName.m_data, LongName.Size());
+        }
+    };
+
+    /// @brief Parser with schema fixed at compile time, fills user struct directly.
+    /// Name matching and conversions are generated per option, so there are no maps,
+    /// type switches or name lookups at runtime. Members which are absent in input keep their values,
+    /// so member initializers of struct are defaults. Options marked as required must be present.
+    /// Schema is independent of ArgumentParser and supports named options only: there are no
+    /// positional arguments, prefixes are always "-" and "--" (SetPrefixChars doesn't apply),
+    /// and there are no choices, abbreviations, help, environment, config or response files.
+    /// Example: Schema<Opts, Option<&Opts::threads, "threads", 't', true>, Option<&Opts::verbose, "verbose">>
+    /// @tparam Struct type of user struct
+    /// @tparam Options list of Option
+    template<typename Struct, typename... Options>
+    class Schema
+    {
+        static_assert((std::is_same_v<typename Options::StructType, Struct> && ...), "all options must point to members of Struct");
+
+    public:
+        /// @brief Parses range of string-like tokens into struct
+        /// @param out struct to fill
+        /// @param first iterator to first token
+        /// @param last iterator past the last token
+        /// @param error message of first error if parsing failed
+        /// @return true if parsing successful
+        template<typename Iterator>
+        static bool Parse(Struct& out, Iterator first, Iterator last, std::string& error)
+        {
+            detail::RangeTokens<Iterator> tokens(first, last);
+            return _parseTokens(out, tokens, error);
+        }
+
+        /// @brief Parses vector of tokens into struct
+        /// @param out struct to fill
+        /// @param args vector of input tokens
+        /// @param error message of first error if parsing failed
+        /// @return true if parsing successful
+        static bool Parse(Struct& out, const std::vector<std::string>& args, std::string& error)
+        {
+            return Parse(out, args.begin(), args.end(), error);
+        }
+
+        /// @brief Parses argc and argv into struct, program name is skipped
+        /// @param out struct to fill
+        /// @param argc count of arguments
+        /// @param argv pointer to array of char*
+        /// @param error message of first error if parsing failed
+        /// @return true if parsing successful
+        static bool Parse(Struct& out, const int argc, char** argv, std::string& error)
+        {
+            if (argc < 1)
+            {
+                return Parse(out, argv, argv, error);
+            }
+            return Parse(out, argv + 1, argv + argc, error);
+        }
+
+    private:
+        template<typename TokenSource>
+        static bool _parseTokens(Struct& out, TokenSource& tokens, std::string& error)
+        {
+            return _parseTokens(out, tokens, error, std::index_sequence_for<Options...>());
+        }
+
+        template<typename TokenSource, size_t... Indexes>
+        static bool _parseTokens(Struct& out, TokenSource& tokens, std::string& error, std::index_sequence<Indexes...>)
+        {
+            // presence of options for required check, one more element to allow empty schema
+            bool seen[sizeof...(Options) + 1] = {};
+            StringView token;
+            size_t position = 0;
+            bool hasToken = _next(tokens, token, position);
+            while (hasToken)
+            {
+                bool known = false;
+                if (!(_tryOption<Options>(out, tokens, token, hasToken, position, known, seen[Indexes], error) && ...))
+                {
+                    return false;
+                }
+                if (!known)
+                {
+                    error = "Unknown input argument: \"" + std::string(token) + "\" at position " + std::to_string(position);
+                    return false;
+                }
+            }
+            static_cast<void>(seen); // unused by empty schema
+            return (_checkRequired<Options>(seen[Indexes], error) && ...);
+        }
+
+        /// @brief Takes next token and counts position of it in input
+        template<typename TokenSource>
+        static bool _next(TokenSource& tokens, StringView& token, size_t& position)
+        {
+            if (!tokens.Next(token))
+            {
+                return false;
+            }
+            ++position;
+            return true;
+        }
+
+        static bool _isOptionLike(StringView token)
+        {
+            return token.size() > 1 && token[0] == '-' && !isNumber(token);
+        }
+
+        /// @brief Consumes option and its values if token is name of this option.
+        /// On match token is moved to first token after option values.
+        template<typename Opt, typename TokenSource>
+        static bool _tryOption(Struct& out, TokenSource& tokens, StringView& token, bool& hasToken, size_t& position, bool& known, bool& seen, std::string& error)
+        {
+            if (known || !Opt::Matches(token))
+            {
+                return true;
+            }
+            known = true;
+            seen = true;
+
+            auto& member = out.*Opt::kMember;
+            if constexpr (Opt::kIsFlag)
+            {
+                member = true;
+                hasToken = _next(tokens, token, position);
+            }
+            else if constexpr (Opt::kIsList)
+            {
+                member.clear();
+                while ((hasToken = _next(tokens, token, position)) && !_isOptionLike(token))
+                {
+                    typename detail::ElementOf<typename Opt::ValueType>::Type value{};
+                    if (!detail::convertToken(token, value))
+                    {
+                        return _cannotParse<Opt>(token, error);
+                    }
+                    member.push_back(std::move(value));
+                }
+            }
+            else
+            {
+                if (!_next(tokens, token, position))
+                {
+                    error = "Wrong arguments count for argument with name \"" + Opt::Name() + "\" got = 0";
+                    return false;
+                }
+                if (!detail::convertToken(token, member))
+                {
+                    return _cannotParse<Opt>(token, error);
+                }
+                hasToken = _next(tokens, token, position);
+            }
+            return true;
+        }
+
+        template<typename Opt>
+        static bool _checkRequired(bool seen, std::string& error)
+        {
+            if (Opt::kRequired && !seen)
+            {
+                error = "Required argument with name \"" + Opt::Name() + "\" doesn't exists";
+                return false;
+            }
+            return true;
+        }
+
+        template<typename Opt>
+        static bool _cannotParse(StringView token, std::string& error)
+        {
+            error = "cannot parse [\"" + std::string(token) + "\"] for  argument \"" + Opt::Name() + "\"";
+            return false;
+        }
+    };
+#endif // ARGPARSE_HAS_CXX20
+}
+
+#if defined(ARGPARSE_ENABLE_STATS) && defined(ARGPARSE_STATS_IMPLEMENTATION)
+// replacement of global allocation functions which counts allocations for ParseStats,
+// must be compiled in exactly one translation unit
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+// gcc doesn't see that both functions are replaced and warns about free of operator new memory
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(size_t size)
+{
+    ARGPARSE_NAMESPACE_NAME::RecordAllocation(size);
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+#endif // ARGPARSE_STATS_IMPLEMENTATION
@@ -0,0 +1,615 @@
+// Microbenchmarks of argparse.h parsing hot paths.
+//
+// Build and run from repository root:
+//   g++ -std=c++17 -O2 -pthread -I. bench/argparse_bench.cpp -o argparse_bench
+//   ./argparse_bench > bench_output.json
+//
+// Options:
+//   --filter NAME   run only scenarios which name contains NAME
+//   --min-time SEC  minimal measuring time of each case (0.2 by default)
+//
+// Results are written to stdout as JSON, one entry per scenario and parameter,
+// so output of two commits could be compared by any JSON tool.
+// Global operator new is replaced to count allocations per operation, so don't build
+// it with ARGPARSE_STATS_IMPLEMENTATION. reuse/parse_into fails if it allocates after warm up.
+
+#include "argparse.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace argparse;
+
+namespace
+{
+    /// @brief Count of calls of global operator new, ParseBatch allocates from several threads
+    std::atomic<size_t> g_allocations(0);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+// gcc doesn't see that both functions are replaced and warns about free of operator new memory
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+namespace
+{
+    /// @brief Result of one benchmark case
+    struct BenchResult
+    {
+        std::string name;
+        size_t      param;
+        size_t      iterations;
+        double      nsPerOp;
+        /// @brief command lines parsed by one operation, 0 if scenario doesn't report throughput
+        size_t      linesPerOp;
+        /// @brief calls of operator new per operation after warm up
+        double      allocationsPerOp;
+    };
+
+    /// @brief Keeps value alive, so compiler can't drop measured code
+    volatile size_t g_sink = 0;
+
+    double g_minTime = 0.2;
+    std::string g_filter;
+    std::vector<BenchResult> g_results;
+
+    /// @brief Throughput of scenario which parses several command lines per operation
+    double LinesPerSecond(const BenchResult& result)
+    {
+        return static_cast<double>(result.linesPerOp) * 1e9 / result.nsPerOp;
+    }
+
+    /// @brief Runs function in growing batches until minimal time is spent
+    /// @param name name of scenario
+    /// @param param parameter of scenario (count of options, tokens and so on)
+    /// @param func measured function, returns any value to sink
+    /// @param linesPerOp command lines parsed by one call of func, reported as lines_per_sec if not 0
+    void Run(const std::string& name, size_t param, const std::function<size_t()>& func, size_t linesPerOp = 0)
+    {
+        if (!g_filter.empty() && name.find(g_filter) == std::string::npos)
+        {
+            return;
+        }
+        typedef std::chrono::steady_clock Clock;
+        // warm up, reused storage reaches its steady size in a few calls
+        for (size_t i = 0; i < 3; ++i)
+        {
+            g_sink = g_sink + func();
+        }
+        size_t iterations = 1;
+        while (true)
+        {
+            const size_t allocations = g_allocations.load();
+            const Clock::time_point start = Clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                g_sink = g_sink + func();
+            }
+            const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            if (seconds >= g_minTime || iterations >= (size_t(1) << 30))
+            {
+                const double allocationsPerOp = static_cast<double>(g_allocations.load() - allocations) / static_cast<double>(iterations);
+                g_results.push_back({ name, param, iterations, seconds * 1e9 / static_cast<double>(iterations), linesPerOp, allocationsPerOp });
+                std::cerr << name << "/" << param << ": " << g_results.back().nsPerOp << " ns, " << allocationsPerOp << " allocations";
+                if (linesPerOp != 0)
+                {
+                    std::cerr << ", " << LinesPerSecond(g_results.back()) << " lines/s";
+                }
+                std::cerr << "\n";
+                return;
+            }
+            iterations = seconds < g_minTime / 100 ? iterations * 10 : iterations * 2;
+        }
+    }
+
+    /// @brief Checks that scenario input is parsed successfully, otherwise timings are meaningless
+    size_t Checked(const ArgumentsObject& result)
+    {
+        if (!result.IsArgValid())
+        {
+            throw std::runtime_error("benchmark input is not valid: " + result.GetErrorString());
+        }
+        return result.ParsedArgsCount();
+    }
+
+    std::string OptionName(size_t index)
+    {
+        return "option" + std::to_string(index);
+    }
+
+    /// @brief Parser with count int options, without auto short names
+    ArgumentParser MakeOptionsParser(size_t count)
+    {
+        ArgumentParser parser("bench");
+        parser.SetAllowAbbrev(false);
+        for (size_t i = 0; i < count; ++i)
+        {
+            parser.AddArgument(CreateNamedArgument("", OptionName(i), 1, ArgTypeCast::e_int, false).SetHelp("option number " + std::to_string(i)));
+        }
+        parser.Freeze();
+        return parser;
+    }
+
+    void BenchOptionCount()
+    {
+        for (size_t count : { 10, 100, 1000 })
+        {
+            const ArgumentParser parser = MakeOptionsParser(count);
+            std::vector<std::string> tokens;
+            for (size_t i = 0; i < count; ++i)
+            {
+                tokens.push_back("--" + OptionName(i));
+                tokens.push_back(std::to_string(i));
+            }
+            Checked(parser.ParseArgs(tokens));
+            Run("options/parse", count, [&]() { return parser.ParseArgs(tokens).ParsedArgsCount(); });
+
+            const ArgumentsObject result = parser.ParseArgs(tokens);
+            const std::string last = OptionName(count - 1);
+            Run("options/get_arg", count, [&]() { return result.GetArg(last).GetArgumentCount(); });
+        }
+    }
+
+    void BenchNameLookup()
+    {
+        for (size_t count : { 10, 100, 1000 })
+        {
+            std::vector<std::pair<std::string, size_t>> keys;
+            std::map<std::string, size_t> map;
+            for (size_t i = 0; i < count; ++i)
+            {
+                keys.emplace_back("--" + OptionName(i), i);
+                map["--" + OptionName(i)] = i;
+            }
+            detail::PerfectHashIndex index;
+            index.Build(keys);
+            std::vector<StringView> queries;
+            for (const auto& key : keys)
+            {
+                queries.push_back(StringView(key.first.data(), key.first.size()));
+            }
+
+            Run("lookup/perfect_hash", count, [&]()
+            {
+                size_t sum = 0;
+                for (const StringView& query : queries)
+                {
+                    sum += index.Find(query);
+                }
+                return sum;
+            });
+            Run("lookup/std_map", count, [&]()
+            {
+                size_t sum = 0;
+                for (const StringView& query : queries)
+                {
+                    sum += map.find(std::string(query.data(), query.size()))->second;
+                }
+                return sum;
+            });
+        }
+    }
+
+    void BenchTokenCount()
+    {
+        ArgumentParser parser("bench");
+        parser.AddArgument(CreateNamedArgument("v", "verbose", 0, ArgTypeCast::e_bool, false));
+        parser.AddArgument(CreatePositionalArgument("files", kFromOneToInfinteArgCount, ArgTypeCast::e_String, true));
+        parser.Freeze();
+        for (size_t count : { 10, 1000, 100000 })
+        {
+            std::vector<std::string> tokens;
+            for (size_t i = 0; i < count; ++i)
+            {
+                tokens.push_back("file_" + std::to_string(i) + ".txt");
+            }
+            tokens.push_back("-v");
+            Checked(parser.ParseArgs(tokens));
+            Run("tokens/positional", count, [&]() { return parser.ParseArgs(tokens).ParsedArgsCount(); });
+
+            std::string line;
+            for (const std::string& token : tokens)
+            {
+                line += token;
+                line += ' ';
+            }
+            Checked(parser.ParseCommandLine(line));
+            Run("tokens/command_line", count, [&]() { return parser.ParseCommandLine(line).ParsedArgsCount(); });
+        }
+    }
+
+    void BenchVariadic()
+    {
+        ArgumentParser parser("bench");
+        parser.AddArgument(CreateNamedArgument("s", "strings", kAnyArgCount, ArgTypeCast::e_String, false));
+        parser.AddArgument(CreateNamedArgument("i", "ints", kFromOneToInfinteArgCount, ArgTypeCast::e_int, false));
+        parser.Freeze();
+        for (size_t count : { 1, 100, 10000 })
+        {
+            std::vector<std::string> tokens{ "--strings" };
+            for (size_t i = 0; i < count; ++i)
+            {
+                tokens.push_back("value" + std::to_string(i));
+            }
+            tokens.push_back("--ints");
+            for (size_t i = 0; i < count; ++i)
+            {
+                tokens.push_back(std::to_string(i));
+            }
+            Checked(parser.ParseArgs(tokens));
+            Run("variadic/nargs", count, [&]() { return parser.ParseArgs(tokens).ParsedArgsCount(); });
+        }
+    }
+
+    void BenchChoices()
+    {
+        for (size_t count : { 10, 100, 10000 })
+        {
+            std::vector<std::string> stringChoices;
+            std::vector<int> intChoices;
+            for (size_t i = 0; i < count; ++i)
+            {
+                stringChoices.push_back("choice" + std::to_string(i));
+                intChoices.push_back(static_cast<int>(i * 3));
+            }
+            ArgumentParser parser("bench");
+            parser.AddArgument(CreateNamedArgument("s", "string", kAnyArgCount, ArgTypeCast::e_String, false).SetChoices(stringChoices));
+            parser.AddArgument(CreateNamedArgument("i", "int", kAnyArgCount, ArgTypeCast::e_int, false).SetChoices(intChoices));
+            parser.Freeze();
+
+            std::vector<std::string> tokens{ "--string" };
+            for (size_t i = 0; i < 100; ++i)
+            {
+                tokens.push_back(stringChoices[(i * 7919) % count]);
+            }
+            tokens.push_back("--int");
+            for (size_t i = 0; i < 100; ++i)
+            {
+                tokens.push_back(std::to_string(intChoices[(i * 7919) % count]));
+            }
+            Checked(parser.ParseArgs(tokens));
+            Run("choices/100_values", count, [&]() { return parser.ParseArgs(tokens).ParsedArgsCount(); });
+        }
+    }
+
+    void BenchNumeric()
+    {
+        ArgumentParser parser("bench");
+        parser.AddArgument(CreateNamedArgument("i", "ints", kAnyArgCount, ArgTypeCast::e_int, false));
+        parser.AddArgument(CreateNamedArgument("l", "longs", kAnyArgCount, ArgTypeCast::e_longlong, false));
+        parser.AddArgument(CreateNamedArgument("d", "doubles", kAnyArgCount, ArgTypeCast::e_double, false));
+        parser.Freeze();
+        const size_t count = 1000;
+        std::vector<std::string> ints{ "--ints" }, longs{ "--longs" }, doubles{ "--doubles" };
+        for (size_t i = 0; i < count; ++i)
+        {
+            ints.push_back(std::to_string(i * 2654435761u % 2000000000u));
+            longs.push_back(std::to_string(static_cast<long long>(i) * 1234567890123LL));
+            doubles.push_back(std::to_string(static_cast<double>(i) / 7.0));
+        }
+        Checked(parser.ParseArgs(ints));
+        Checked(parser.ParseArgs(longs));
+        Checked(parser.ParseArgs(doubles));
+        Run("numeric/int", count, [&]() { return parser.ParseArgs(ints).ParsedArgsCount(); });
+        Run("numeric/long_long", count, [&]() { return parser.ParseArgs(longs).ParsedArgsCount(); });
+        Run("numeric/double", count, [&]() { return parser.ParseArgs(doubles).ParsedArgsCount(); });
+    }
+
+    void BenchAbbreviations()
+    {
+        // every option is used by its one letter name
+        const std::string letters = "abcdefgijklmnopqrstuvwxyz";
+        ArgumentParser parser("bench");
+        for (char letter : letters)
+        {
+            parser.AddArgument(CreateNamedArgument(std::string(1, letter), std::string(1, letter) + "option", kAnyArgCount, ArgTypeCast::e_int, false));
+        }
+        parser.Freeze();
+        for (size_t repeats : { 1, 40 })
+        {
+            std::vector<std::string> tokens;
+            for (size_t r = 0; r < repeats; ++r)
+            {
+                for (char letter : letters)
+                {
+                    tokens.push_back(std::string("-") + letter);
+                    tokens.push_back(std::to_string(r));
+                }
+            }
+            Checked(parser.ParseArgs(tokens));
+            Run("abbreviations/short_names", tokens.size(), [&]() { return parser.ParseArgs(tokens).ParsedArgsCount(); });
+        }
+        Run("abbreviations/freeze", 1000, [&]()
+        {
+            // short names are generated for options without them
+            ArgumentParser generated("bench");
+            for (size_t i = 0; i < 1000; ++i)
+            {
+                generated.AddArgument(CreateNamedArgument("", OptionName(i), 1, ArgTypeCast::e_int, false));
+            }
+            return generated.Freeze().IsFrozen() ? size_t(1) : size_t(0);
+        });
+
+        // every option is used by its shortest unambiguous prefix of long name
+        for (size_t count : { 10, 100, 1000 })
+        {
+            ArgumentParser parser("bench");
+            for (size_t i = 0; i < count; ++i)
+            {
+                parser.AddArgument(CreateNamedArgument("", OptionName(i) + "_value", 1, ArgTypeCast::e_int, false));
+            }
+            parser.Freeze();
+            std::vector<std::string> tokens;
+            for (size_t i = 0; i < count; ++i)
+            {
+                tokens.push_back("--" + OptionName(i) + "_");
+                tokens.push_back(std::to_string(i));
+            }
+            Checked(parser.ParseArgs(tokens));
+            Run("abbreviations/long_prefix", count, [&]() { return parser.ParseArgs(tokens).ParsedArgsCount(); });
+        }
+    }
+
+    /// @brief Levenshtein distance by full matrix, baseline for suggestions
+    size_t DynamicDistance(const std::string& lhs, const std::string& rhs)
+    {
+        std::vector<size_t> row(rhs.size() + 1);
+        for (size_t j = 0; j <= rhs.size(); ++j)
+        {
+            row[j] = j;
+        }
+        for (size_t i = 1; i <= lhs.size(); ++i)
+        {
+            size_t diagonal = row[0];
+            row[0] = i;
+            for (size_t j = 1; j <= rhs.size(); ++j)
+            {
+                const size_t above = row[j];
+                row[j] = std::min(std::min(row[j] + 1, row[j - 1] + 1), diagonal + (lhs[i - 1] != rhs[j - 1] ? 1 : 0));
+                diagonal = above;
+            }
+        }
+        return row[rhs.size()];
+    }
+
+    void BenchSuggestions()
+    {
+        for (size_t count : { 100, 1000, 10000 })
+        {
+            // names differ only by number, so length pruning can't drop most of them
+            std::vector<std::string> names;
+            for (size_t i = 0; i < count; ++i)
+            {
+                names.push_back("--" + OptionName(i));
+            }
+            detail::SuggestionIndex index;
+            index.Build(names);
+            const std::string typo = "--optoin" + std::to_string(count / 2);
+            if (index.Suggest(typo, 3, 3).empty())
+            {
+                throw std::runtime_error("benchmark input is not valid: no suggestion for " + typo);
+            }
+
+            Run("suggestions/bit_parallel", count, [&]() { return index.Suggest(typo, 3, 3).size(); });
+            Run("suggestions/dynamic_programming", count, [&]()
+            {
+                size_t best = 4;
+                for (const std::string& name : names)
+                {
+                    best = std::min(best, DynamicDistance(typo, name));
+                }
+                return best;
+            });
+        }
+
+        const ArgumentParser parser = MakeOptionsParser(1000);
+        const std::vector<std::string> tokens{ "--optoin500", "1" };
+        if (parser.ParseArgs(tokens).GetErrorString().find("Did you mean") == std::string::npos)
+        {
+            throw std::runtime_error("benchmark input is not valid: no suggestion in error");
+        }
+        Run("suggestions/parse_error", 1000, [&]() { return parser.ParseArgs(tokens).GetErrorString().size(); });
+    }
+
+    void BenchHelp()
+    {
+        for (size_t count : { 10, 100, 1000 })
+        {
+            ArgumentParser parser = MakeOptionsParser(count);
+            parser.SetDescription("Benchmark of help rendering with long description which has to be wrapped to several lines of output.");
+            Run("help/render", count, [&]() { return parser.GetHelp().size(); });
+        }
+    }
+
+    void BenchReuse()
+    {
+        ArgumentParser parser = MakeOptionsParser(100);
+        std::vector<std::string> tokens;
+        for (size_t i = 0; i < 100; ++i)
+        {
+            tokens.push_back("--" + OptionName(i));
+            tokens.push_back(std::to_string(i));
+        }
+        Checked(parser.ParseArgs(tokens));
+        Run("reuse/parse_args", 100, [&]() { return parser.ParseArgs(tokens).ParsedArgsCount(); });
+        ArgumentsObject result;
+        Run("reuse/parse_into", 100, [&]() { return parser.ParseInto(result, tokens) ? result.ParsedArgsCount() : 0; });
+        // reused result should keep all its storage, so steady state doesn't allocate at all
+        if (!g_results.empty() && g_results.back().name == "reuse/parse_into" && g_results.back().allocationsPerOp != 0)
+        {
+            throw std::runtime_error("reuse/parse_into allocates after warm up: " + std::to_string(g_results.back().allocationsPerOp) + " per parse");
+        }
+    }
+
+    void BenchBatch()
+    {
+        const ArgumentParser parser = MakeOptionsParser(100);
+        std::vector<std::vector<std::string>> lines(4096);
+        for (size_t line = 0; line < lines.size(); ++line)
+        {
+            for (size_t i = 0; i < 100; i += 7)
+            {
+                lines[line].push_back("--" + OptionName(i));
+                lines[line].push_back(std::to_string(line + i));
+            }
+        }
+        Checked(parser.ParseArgs(lines.front()));
+        // param is count of threads, throughput is reported as lines_per_sec
+        for (size_t threads : { 1, 2, 4, 8, 16 })
+        {
+            Run("batch/threads", threads, [&]() { return parser.ParseBatch(lines, threads).size(); }, lines.size());
+        }
+    }
+
+    /// @brief Removes file on scope exit, also when benchmark throws
+    struct RemoveFileOnExit
+    {
+        const char* path;
+
+        ~RemoveFileOnExit()
+        {
+            std::remove(path);
+        }
+    };
+
+    void BenchConfig()
+    {
+        const char* path = "argparse_bench_config.ini";
+        const RemoveFileOnExit remove = { path };
+        {
+            std::ofstream file(path);
+            file << "# generated by argparse_bench\n[other]\n";
+            for (size_t i = 0; i < 5000; ++i)
+            {
+                file << "key" << i << " = \"skipped value " << i << "\"\n";
+            }
+            file << "[bench]\n";
+            for (size_t i = 0; i < 5000; ++i)
+            {
+                file << OptionName(i % 200) << " = " << i << "\n";
+            }
+        }
+        Run("config/startup_10k_lines", 10000, [&]()
+        {
+            ArgumentParser parser("bench");
+            parser.SetAllowAbbrev(false);
+            for (size_t i = 0; i < 200; ++i)
+            {
+                parser.AddArgument(CreateNamedArgument("", OptionName(i), 1, ArgTypeCast::e_int, false));
+            }
+            parser.AddConfigFile(path, ConfigFormat::e_Ini, "bench");
+            return Checked(parser.ParseArgs(std::vector<std::string>{}));
+        });
+    }
+
+    void PrintJson()
+    {
+        std::cout << "{\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < g_results.size(); ++i)
+        {
+            const BenchResult& result = g_results[i];
+            std::cout << "    {\"name\": \"" << result.name << "\", \"param\": " << result.param
+                << ", \"iterations\": " << result.iterations << ", \"ns_per_op\": " << result.nsPerOp
+                << ", \"allocations_per_op\": " << result.allocationsPerOp;
+            if (result.linesPerOp != 0)
+            {
+                std::cout << ", \"lines_per_sec\": " << LinesPerSecond(result);
+            }
+            std::cout << "}" << (i + 1 == g_results.size() ? "\n" : ",\n");
+        }
+        std::cout << "  ]\n}\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    ArgumentParser options("argparse_bench");
+    options.SetDescription("Microbenchmarks of argument parser, prints JSON to stdout");
+    options.AddArgument(CreateNamedArgument("f", "filter", 1, ArgTypeCast::e_String, false).SetHelp("run only scenarios containing this string"));
+    options.AddArgument(CreateNamedArgument("t", "min-time", 1, ArgTypeCast::e_double, false).SetHelp("minimal time of each case in seconds"));
+    ArgumentsObject args = options.ParseArgs(argc, argv);
+    if (!args.IsArgValid())
+    {
+        std::cerr << args.GetErrorString() << "\n" << options.GetHelp();
+        return 1;
+    }
+    if (args.GetArg("help").GetArgumentExists())
+    {
+        std::cout << options.GetHelp();
+        return 0;
+    }
+    if (args.GetArg("filter").GetArgumentExists())
+    {
+        g_filter = args.GetArg("filter").GetAsString();
+    }
+    if (args.GetArg("min-time").GetArgumentExists())
+    {
+        g_minTime = args.GetArg("min-time").GetAsDouble();
+    }
+
+    BenchOptionCount();
+    BenchNameLookup();
+    BenchTokenCount();
+    BenchVariadic();
+    BenchChoices();
+    BenchNumeric();
+    BenchAbbreviations();
+    BenchSuggestions();
+    BenchHelp();
+    BenchReuse();
+    BenchBatch();
+    BenchConfig();
+
+    PrintJson();
+    return g_sink == 42 ? 2 : 0;
+}
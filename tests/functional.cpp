@@ -0,0 +1,390 @@
+// Functional test of parser features: value sources and their precedence, config files,
+// command line tokenizer, abbreviations, subcommands, lazy conversion and bound variables.
+//
+// Build and run from repository root:
+//   g++ -std=c++17 -g -fsanitize=address,undefined -I. tests/functional.cpp -o functional
+//   ./functional
+//
+// Test writes its input files to current directory and removes them at exit.
+// Exit code is 0 if every check passed, failed check aborts with its expression.
+
+#undef NDEBUG
+#include "argparse.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace argparse;
+
+namespace
+{
+    /// @brief Writes file on construction and removes it on destruction
+    struct TempFile
+    {
+        std::string path;
+
+        TempFile(const std::string& name, const std::string& text)
+            : path(name)
+        {
+            std::ofstream file(path, std::ios::out | std::ios::binary);
+            file << text;
+        }
+
+        ~TempFile()
+        {
+            std::remove(path.c_str());
+        }
+    };
+
+    void SetEnvironment(const char* name, const char* value)
+    {
+#ifdef _WIN32
+        _putenv_s(name, value == nullptr ? "" : value);
+#else
+        if (value == nullptr)
+        {
+            unsetenv(name);
+        }
+        else
+        {
+            setenv(name, value, 1);
+        }
+#endif
+    }
+
+    bool Contains(const std::string& text, const std::string& part)
+    {
+        return text.find(part) != std::string::npos;
+    }
+
+    void TestSourcePrecedence()
+    {
+        const TempFile low("argparse_test_low.ini", "level = 2\nname = low\n");
+        const TempFile high("argparse_test_high.ini", "# comment\n[other]\nlevel = 8\n[app]\nlevel = 3\n");
+
+        ArgumentParser parser("precedence");
+        parser.AddArgument(CreateNamedArgument("", "level", 1, ArgTypeCast::e_int, false).SetDefault(1).SetEnv("ARGPARSE_TEST_LEVEL"));
+        parser.AddArgument(CreateNamedArgument("", "name", 1, ArgTypeCast::e_String, false));
+        parser.AddArgument(CreateNamedArgument("", "other", 1, ArgTypeCast::e_int, false).SetDefault(1));
+        parser.AddConfigFile(low.path, ConfigFormat::e_Ini);
+        parser.AddConfigFile(high.path, ConfigFormat::e_Ini, "app");
+        parser.AddConfigFile("argparse_test_missing.ini", ConfigFormat::e_Ini);
+
+        SetEnvironment("ARGPARSE_TEST_LEVEL", "4");
+        const ArgumentsObject commandLine = parser.ParseArgs(std::vector<std::string>{ "--level", "5" });
+        assert(commandLine.IsArgValid());
+        assert(commandLine.GetArg("level").GetAsInt() == 5);
+
+        const ArgumentsObject environment = parser.ParseArgs(std::vector<std::string>{});
+        assert(environment.IsArgValid());
+        assert(environment.GetArg("level").GetAsInt() == 4);
+
+        SetEnvironment("ARGPARSE_TEST_LEVEL", nullptr);
+        const ArgumentsObject config = parser.ParseArgs(std::vector<std::string>{});
+        assert(config.IsArgValid());
+        // later file wins, earlier file still gives keys later one doesn't have, missing file is skipped
+        assert(config.GetArg("level").GetAsInt() == 3);
+        assert(config.GetArg("name").GetAsString() == "low");
+        assert(config.GetArg("other").GetAsInt() == 1);
+    }
+
+    void TestPositionalEnvironment()
+    {
+        ArgumentParser parser("positional");
+        parser.AddArgument(CreatePositionalArgument("input", 1, ArgTypeCast::e_String, false).SetEnv("ARGPARSE_TEST_INPUT"));
+        SetEnvironment("ARGPARSE_TEST_INPUT", "environment");
+
+        const ArgumentsObject commandLine = parser.ParseArgs(std::vector<std::string>{ "command" });
+        assert(commandLine.IsArgValid());
+        assert(commandLine.GetArg("input").GetAsString() == "command");
+
+        const ArgumentsObject environment = parser.ParseArgs(std::vector<std::string>{});
+        assert(environment.IsArgValid());
+        assert(environment.GetArg("input").GetAsString() == "environment");
+        SetEnvironment("ARGPARSE_TEST_INPUT", nullptr);
+    }
+
+    void TestConfigErrors()
+    {
+        const TempFile broken("argparse_test_broken.ini", "level = 1\n[app\n");
+        ArgumentParser ini("ini");
+        ini.AddArgument(CreateNamedArgument("", "level", 1, ArgTypeCast::e_int, false));
+        ini.AddConfigFile(broken.path, ConfigFormat::e_Ini);
+        const ArgumentsObject iniResult = ini.ParseArgs(std::vector<std::string>{ "--level", "1" });
+        assert(!iniResult.IsArgValid());
+        assert(Contains(iniResult.GetErrorString(), broken.path));
+        assert(Contains(iniResult.GetErrorString(), "at line 2"));
+
+        const TempFile json("argparse_test_broken.json", "{ \"level\": 1 \"name\": 2 }");
+        ArgumentParser jsonParser("json");
+        jsonParser.AddArgument(CreateNamedArgument("", "level", 1, ArgTypeCast::e_int, false));
+        jsonParser.AddConfigFile(json.path, ConfigFormat::e_Json);
+        const ArgumentsObject jsonResult = jsonParser.ParseArgs(std::vector<std::string>{});
+        assert(!jsonResult.IsArgValid());
+        assert(Contains(jsonResult.GetErrorString(), "expected , or }"));
+
+        const TempFile wrongValue("argparse_test_value.ini", "level = high\n");
+        ArgumentParser value("value");
+        value.AddArgument(CreateNamedArgument("", "level", 1, ArgTypeCast::e_int, false));
+        value.AddConfigFile(wrongValue.path, ConfigFormat::e_Ini);
+        assert(!value.ParseArgs(std::vector<std::string>{}).IsArgValid());
+        assert(value.ParseArgs(std::vector<std::string>{ "--level", "2" }).IsArgValid());
+    }
+
+    void TestJsonSections()
+    {
+        const TempFile json("argparse_test_sections.json",
+            "{\n"
+            "  \"level\": 1,\n"
+            "  \"build\": { \"level\": 9, \"name\": \"skipped\" },\n"
+            "  \"app\": { \"unknown\": { \"deep\": [1, 2] }, \"level\": 7, \"name\": \"a\\\"b\\u0041\", \"list\": [1, 2, 3], \"fast\": true }\n"
+            "}\n");
+        ArgumentParser parser("sections");
+        parser.AddArgument(CreateNamedArgument("", "level", 1, ArgTypeCast::e_int, false));
+        parser.AddArgument(CreateNamedArgument("", "name", 1, ArgTypeCast::e_String, false));
+        parser.AddArgument(CreateNamedArgument("", "list", kAnyArgCount, ArgTypeCast::e_int, false));
+        parser.AddArgument(CreateNamedArgument("", "fast", 0, ArgTypeCast::e_bool, false));
+        parser.AddConfigFile(json.path, ConfigFormat::e_Json, "app");
+
+        const ArgumentsObject result = parser.ParseArgs(std::vector<std::string>{});
+        assert(result.IsArgValid());
+        assert(result.GetArg("level").GetAsInt() == 7);
+        assert(result.GetArg("name").GetAsString() == "a\"bA");
+        assert(result.GetArg("list").GetAsVecInt().size() == 3);
+        assert(result.GetArg("fast").GetArgumentExists());
+    }
+
+    void TestResponseFiles()
+    {
+        const TempFile nested("argparse_test_nested.rsp", "--level 6\n");
+        const TempFile outer("argparse_test_outer.rsp", "--name outer @argparse_test_nested.rsp");
+        const TempFile loop("argparse_test_loop.rsp", "@argparse_test_loop.rsp");
+        ArgumentParser parser("response");
+        parser.SetFromFilePrefixChars('@');
+        parser.AddArgument(CreateNamedArgument("", "level", 1, ArgTypeCast::e_int, false));
+        parser.AddArgument(CreateNamedArgument("", "name", 1, ArgTypeCast::e_String, false));
+
+        const ArgumentsObject result = parser.ParseArgs(std::vector<std::string>{ "@" + outer.path });
+        assert(result.IsArgValid());
+        assert(result.GetArg("name").GetAsString() == "outer");
+        assert(result.GetArg("level").GetAsInt() == 6);
+
+        const ArgumentsObject missing = parser.ParseArgs(std::vector<std::string>{ "@argparse_test_missing.rsp" });
+        assert(!missing.IsArgValid());
+        assert(Contains(missing.GetErrorString(), "Cannot read arguments file"));
+
+        const ArgumentsObject recursive = parser.ParseArgs(std::vector<std::string>{ "@" + loop.path });
+        assert(!recursive.IsArgValid());
+        assert(Contains(recursive.GetErrorString(), "includes itself"));
+    }
+
+    void TestCommandLineTokenizer()
+    {
+        ArgumentParser parser("tokenizer");
+        parser.AddArgument(CreateNamedArgument("", "words", kAnyArgCount, ArgTypeCast::e_String, false));
+
+        const ArgumentsObject result = parser.ParseCommandLine("--words plain 'single $quoted' \"double \\\"escaped\\\" \\$x\" back\\ slash \"\" mixed'a'\"b\"");
+        assert(result.IsArgValid());
+        const ValuesOf<std::string>& words = result.GetArg("words").GetAsVecString();
+        assert(words.size() == 6);
+        assert(words[0] == "plain");
+        assert(words[1] == "single $quoted");
+        assert(words[2] == "double \"escaped\" $x");
+        assert(words[3] == "back slash");
+        assert(words[4] == "");
+        assert(words[5] == "mixedab");
+
+        const ArgumentsObject singleQuote = parser.ParseCommandLine("--words 'open");
+        assert(!singleQuote.IsArgValid());
+        assert(Contains(singleQuote.GetErrorString(), "Unterminated single quote"));
+        const ArgumentsObject doubleQuote = parser.ParseCommandLine("--words \"open");
+        assert(!doubleQuote.IsArgValid());
+        assert(Contains(doubleQuote.GetErrorString(), "Unterminated double quote"));
+        const ArgumentsObject escape = parser.ParseCommandLine("--words end\\");
+        assert(!escape.IsArgValid());
+        assert(Contains(escape.GetErrorString(), "escape character"));
+    }
+
+    void TestAbbreviations()
+    {
+        ArgumentParser parser("abbrev");
+        parser.AddArgument(CreateNamedArgument("", "verbose", 0, ArgTypeCast::e_bool, false));
+        parser.AddArgument(CreateNamedArgument("", "version", 0, ArgTypeCast::e_bool, false));
+        parser.AddArgument(CreateNamedArgument("", "num", 1, ArgTypeCast::e_int, false));
+        parser.AddArgument(CreateNamedArgument("", "number", 1, ArgTypeCast::e_int, false));
+
+        const ArgumentsObject unique = parser.ParseArgs(std::vector<std::string>{ "--verb", "--vers", "--num", "1", "--numb", "2" });
+        assert(unique.IsArgValid());
+        assert(unique.GetArg("verbose").GetArgumentExists());
+        assert(unique.GetArg("version").GetArgumentExists());
+        assert(unique.GetArg("num").GetAsInt() == 1);
+        assert(unique.GetArg("number").GetAsInt() == 2);
+
+        const ArgumentsObject ambiguous = parser.ParseArgs(std::vector<std::string>{ "--ver" });
+        assert(!ambiguous.IsArgValid());
+        assert(Contains(ambiguous.GetErrorString(), "Ambiguous input argument"));
+        assert(Contains(ambiguous.GetErrorString(), "--verbose"));
+        assert(Contains(ambiguous.GetErrorString(), "--version"));
+
+        const ArgumentsObject unknown = parser.ParseArgs(std::vector<std::string>{ "--vrebose" });
+        assert(!unknown.IsArgValid());
+        assert(Contains(unknown.GetErrorString(), "--verbose"));
+
+        parser.SetAllowAbbrev(false);
+        assert(!parser.ParseArgs(std::vector<std::string>{ "--verb" }).IsArgValid());
+    }
+
+    void TestGeneratedNames()
+    {
+        ArgumentParser parser("generated");
+        parser.AddArgument(CreateNamedArgument("", "alpha", 1, ArgTypeCast::e_int, false));
+        assert(parser.ParseArgs(std::vector<std::string>{ "-a", "1", "-h" }).IsArgValid());
+
+        // generated -a gives way to explicit name added later
+        parser.AddArgument(CreateNamedArgument("a", "another", 1, ArgTypeCast::e_int, false));
+        const ArgumentsObject explicitName = parser.ParseArgs(std::vector<std::string>{ "-a", "2" });
+        assert(explicitName.IsArgValid());
+        assert(explicitName.GetArg("another").GetAsInt() == 2);
+
+        parser.SetAddHelp(false);
+        assert(!parser.ParseArgs(std::vector<std::string>{ "--help" }).IsArgValid());
+    }
+
+    void TestSubcommands()
+    {
+        ArgumentParser parser("tool");
+        parser.AddArgument(CreateNamedArgument("", "verbose", 0, ArgTypeCast::e_bool, false));
+        parser.AddSubparsers("commands", true);
+        parser.AddSubparser("build", [](ArgumentParser& sub)
+            {
+                sub.AddArgument(CreateNamedArgument("j", "jobs", 1, ArgTypeCast::e_int, true));
+            });
+        parser.AddSubparser("clean", [](ArgumentParser& sub)
+            {
+                sub.AddArgument(CreateNamedArgument("", "all", 0, ArgTypeCast::e_bool, false));
+            });
+
+        const ArgumentsObject build = parser.ParseArgs(std::vector<std::string>{ "--verbose", "build", "-j", "4" });
+        assert(build.IsArgValid());
+        assert(build.GetArg("verbose").GetArgumentExists());
+        assert(build.GetSubcommand() == "build");
+        assert(build.GetSubcommandArgs().GetArg("jobs").GetAsInt() == 4);
+
+        const ArgumentsObject unknown = parser.ParseArgs(std::vector<std::string>{ "deploy" });
+        assert(!unknown.IsArgValid());
+        assert(Contains(unknown.GetErrorString(), "Unknown subcommand"));
+
+        const ArgumentsObject missing = parser.ParseArgs(std::vector<std::string>{ "--verbose" });
+        assert(!missing.IsArgValid());
+        assert(Contains(missing.GetErrorString(), "Subcommand is required"));
+
+        const ArgumentsObject subcommandError = parser.ParseArgs(std::vector<std::string>{ "build" });
+        assert(!subcommandError.IsArgValid());
+        assert(Contains(subcommandError.GetErrorString(), "jobs"));
+    }
+
+    /// @brief Parser is destroyed when function returns, result must stay readable
+    ArgumentsObject ParseLazyWithTemporaryParser(const std::vector<std::string>& tokens)
+    {
+        ArgumentParser parser("lazy");
+        parser.SetLazyConversion(true);
+        parser.AddArgument(CreateNamedArgument("", "xs", kAnyArgCount, ArgTypeCast::e_int, false).SetChoices(std::vector<int>{ 1, 2, 3 }));
+        parser.AddArgument(CreateNamedArgument("", "ratio", 1, ArgTypeCast::e_double, false));
+        return parser.ParseArgs(tokens);
+    }
+
+    void TestLazyConversion()
+    {
+        const ArgumentsObject result = ParseLazyWithTemporaryParser(std::vector<std::string>{ "--xs", "1", "3", "--ratio", "0.25" });
+        assert(result.IsArgValid());
+        assert(result.GetArg("xs").GetAsVecInt().size() == 2);
+        assert(result.GetArg("xs").GetAsVecInt()[1] == 3);
+        assert(result.GetArg("ratio").GetAsDouble() == 0.25);
+
+        // syntax is checked while parsing, so valid result doesn't throw on it later
+        assert(!ParseLazyWithTemporaryParser(std::vector<std::string>{ "--xs", "1.5" }).IsArgValid());
+        assert(!ParseLazyWithTemporaryParser(std::vector<std::string>{ "--ratio", "fast" }).IsArgValid());
+
+        const ArgumentsObject outOfChoices = ParseLazyWithTemporaryParser(std::vector<std::string>{ "--xs", "7" });
+        assert(outOfChoices.IsArgValid());
+        bool threw = false;
+        try
+        {
+            outOfChoices.GetArg("xs").GetAsVecInt();
+        }
+        catch (const std::runtime_error& error)
+        {
+            threw = Contains(error.what(), "out of choices");
+        }
+        assert(threw);
+    }
+
+    void TestBoundVariables()
+    {
+        bool verbose = false;
+        int num = 0;
+        std::vector<std::string> names;
+        ArgumentParser parser("bound");
+        parser.AddArgument(CreateNamedArgument("", "verbose", 0, ArgTypeCast::e_bool, false).BindTo(&verbose));
+        parser.AddArgument(CreateNamedArgument("", "num", 1, ArgTypeCast::e_int, false).BindTo(&num));
+        parser.AddArgument(CreateNamedArgument("", "names", kAnyArgCount, ArgTypeCast::e_String, false).BindTo(&names));
+
+        const ArgumentsObject first = parser.ParseArgs(std::vector<std::string>{ "--verbose", "--num", "5", "--names", "a", "b" });
+        assert(first.IsArgValid());
+        assert(verbose && num == 5 && names.size() == 2);
+        bool threw = false;
+        try
+        {
+            first.GetArg("num").GetAsInt();
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        assert(threw);
+
+        // reused parser resets variables of absent arguments
+        assert(parser.ParseArgs(std::vector<std::string>{}).IsArgValid());
+        assert(!verbose && num == 0 && names.empty());
+    }
+
+    void TestSinks()
+    {
+        std::string joined;
+        long long sum = 0;
+        ArgumentParser parser("sinks");
+        parser.AddArgument(CreateNamedArgument("", "words", kAnyArgCount, ArgTypeCast::e_String, false)
+            .SetSink(std::function<void(StringView)>([&joined](StringView word) { joined.append(word.data(), word.size()); })));
+        parser.AddArgument(CreateNamedArgument("", "values", kAnyArgCount, ArgTypeCast::e_longlong, false)
+            .SetSink(std::function<void(long long)>([&sum](long long value) { sum += value; })));
+
+        const ArgumentsObject result = parser.ParseArgs(std::vector<std::string>{ "--words", "a", "b", "--values", "1", "2", "3" });
+        assert(result.IsArgValid());
+        assert(joined == "ab");
+        assert(sum == 6);
+        assert(result.GetArg("values").GetArgumentCount() == 3);
+    }
+}
+
+int main()
+{
+    TestSourcePrecedence();
+    TestPositionalEnvironment();
+    TestConfigErrors();
+    TestJsonSections();
+    TestResponseFiles();
+    TestCommandLineTokenizer();
+    TestAbbreviations();
+    TestGeneratedNames();
+    TestSubcommands();
+    TestLazyConversion();
+    TestBoundVariables();
+    TestSinks();
+    std::cout << "all checks passed\n";
+    return 0;
+}
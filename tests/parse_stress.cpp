@@ -0,0 +1,164 @@
+// Stress test of concurrent parsing with one shared frozen parser.
+// Many threads parse different command lines through const parser at once
+// and check every result, so data races show up under ThreadSanitizer.
+//
+// Build and run from repository root:
+//   g++ -std=c++17 -O1 -g -fsanitize=thread -pthread -I. tests/parse_stress.cpp -o parse_stress
+//   ./parse_stress
+//
+// Options:
+//   --threads N     count of parsing threads (16 by default)
+//   --iterations N  command lines parsed by each thread (2000 by default)
+//
+// Exit code is 0 if every result is correct.
+// Arguments bound by BindTo are not covered: bound variables are written by every parse,
+// so parser with them can't be shared between threads by design.
+
+#include "argparse.h"
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace argparse;
+
+namespace
+{
+    std::atomic<size_t> g_failures(0);
+    std::atomic<long long> g_sinkSum(0);
+
+    void Check(bool condition, const std::string& what)
+    {
+        if (!condition && g_failures.fetch_add(1) < 10)
+        {
+            std::cerr << "failed: " << what << "\n";
+        }
+    }
+
+    /// @brief Parser with conversions, choices, defaults, sink and lazily built subcommand
+    ArgumentParser MakeParser()
+    {
+        ArgumentParser parser("stress");
+        parser.AddArgument(CreatePositionalArgument("input", 1, ArgTypeCast::e_String, true));
+        parser.AddArgument(CreateNamedArgument("n", "num", 1, ArgTypeCast::e_int, false));
+        parser.AddArgument(CreateNamedArgument("", "ratio", 1, ArgTypeCast::e_double, false).SetDefault(0.5));
+        parser.AddArgument(CreateNamedArgument("m", "mode", 1, ArgTypeCast::e_String, false).SetChoices(std::vector<std::string>{ "fast", "slow" }));
+        parser.AddArgument(CreateNamedArgument("", "verbose", 0, ArgTypeCast::e_bool, false));
+        parser.AddArgument(CreateNamedArgument("", "sum", kAnyArgCount, ArgTypeCast::e_int, false)
+            .SetSink(std::function<void(int)>([](int value) { g_sinkSum += value; })));
+        parser.AddSubparsers("commands", false);
+        parser.AddSubparser("build", [](ArgumentParser& sub)
+            {
+                sub.AddArgument(CreateNamedArgument("j", "jobs", 1, ArgTypeCast::e_int, true));
+            });
+        parser.Freeze();
+        return parser;
+    }
+
+    /// @brief Parser which converts numbers on first access of result
+    ArgumentParser MakeLazyParser()
+    {
+        ArgumentParser parser("lazy");
+        parser.SetLazyConversion(true);
+        parser.AddArgument(CreateNamedArgument("", "count", 1, ArgTypeCast::e_longlong, false));
+        parser.AddArgument(CreateNamedArgument("", "values", kAnyArgCount, ArgTypeCast::e_double, false));
+        parser.Freeze();
+        return parser;
+    }
+
+    void Worker(const ArgumentParser& parser, const ArgumentParser& lazyParser, size_t thread, size_t iterations)
+    {
+        ArgumentsObject reused;
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            const int number = static_cast<int>(thread * 100000 + i);
+            const std::string input = "file" + std::to_string(number);
+            const bool fast = (i % 2) == 0;
+            const std::vector<std::string> tokens{ input, "-n", std::to_string(number), "-m", fast ? "fast" : "slow", "--verbose", "--sum", "1", "2" };
+
+            const ArgumentsObject result = parser.ParseArgs(tokens);
+            Check(result.IsArgValid(), "valid: " + result.GetErrorString());
+            if (result.IsArgValid())
+            {
+                Check(result.GetArg("input").GetAsString() == input, "input");
+                Check(result.GetArg("num").GetAsInt() == number, "num");
+                Check(result.GetArg("mode").GetAsString() == (fast ? "fast" : "slow"), "mode");
+                Check(result.GetArg("ratio").GetAsDouble() == 0.5, "default");
+                Check(result.GetArg("verbose").GetArgumentExists(), "flag");
+                Check(result.GetArg("sum").GetArgumentCount() == 2, "sink count");
+            }
+
+            Check(parser.ParseInto(reused, std::vector<std::string>{ input, "-m", "medium" }) == false, "choices");
+
+            const ArgumentsObject line = parser.ParseCommandLine(input + " --ratio " + std::to_string(i) + " build -j " + std::to_string(number));
+            Check(line.IsArgValid(), "command line: " + line.GetErrorString());
+            if (line.IsArgValid())
+            {
+                Check(line.GetArg("ratio").GetAsDouble() == static_cast<double>(i), "ratio");
+                Check(line.GetSubcommand() == "build", "subcommand");
+                Check(line.GetSubcommandArgs().GetArg("jobs").GetAsInt() == number, "subcommand value");
+            }
+
+            const ArgumentsObject lazy = lazyParser.ParseArgs(std::vector<std::string>{ "--count", std::to_string(number), "--values", "1.5", "2.5" });
+            Check(lazy.IsArgValid(), "lazy: " + lazy.GetErrorString());
+            if (lazy.IsArgValid())
+            {
+                Check(lazy.GetArg("count").GetAsLongLong() == number, "lazy count");
+                Check(lazy.GetArg("values").GetAsVecDouble().size() == 2, "lazy values");
+            }
+        }
+    }
+
+    void BatchWorker(const ArgumentParser& parser, size_t thread)
+    {
+        std::vector<std::string> lines;
+        for (size_t i = 0; i < 256; ++i)
+        {
+            lines.push_back("batch" + std::to_string(thread) + " -n " + std::to_string(i));
+        }
+        const std::vector<ArgumentsObject> results = parser.ParseBatch(lines, 4);
+        Check(results.size() == lines.size(), "batch size");
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            Check(results[i].IsArgValid() && results[i].GetArg("num").GetAsInt() == static_cast<int>(i), "batch order");
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ArgumentParser options("parse_stress");
+    options.AddArgument(CreateNamedArgument("", "threads", 1, ArgTypeCast::e_int, false).SetDefault(16));
+    options.AddArgument(CreateNamedArgument("", "iterations", 1, ArgTypeCast::e_int, false).SetDefault(2000));
+    const ArgumentsObject args = options.ParseArgs(argc, argv);
+    if (!args.IsArgValid() || args.GetArg("help").GetArgumentExists())
+    {
+        std::cerr << args.GetErrorString() << "\n" << options.GetHelp();
+        return args.IsArgValid() ? 0 : 1;
+    }
+    const size_t threadsCount = static_cast<size_t>(args.GetArg("threads").GetAsInt());
+    const size_t iterations = static_cast<size_t>(args.GetArg("iterations").GetAsInt());
+
+    const ArgumentParser parser = MakeParser();
+    const ArgumentParser lazyParser = MakeLazyParser();
+
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < threadsCount; ++thread)
+    {
+        threads.emplace_back(Worker, std::cref(parser), std::cref(lazyParser), thread, iterations);
+    }
+    for (size_t thread = 0; thread < 2; ++thread)
+    {
+        threads.emplace_back(BatchWorker, std::cref(parser), thread);
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    Check(g_sinkSum == static_cast<long long>(threadsCount * iterations * 3), "sink sum");
+    std::cout << threadsCount << " threads, " << iterations << " iterations, " << g_failures << " failures\n";
+    return g_failures == 0 ? 0 : 1;
+}